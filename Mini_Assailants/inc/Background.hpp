@@ -1,6 +1,8 @@
 #pragma once
 
-//Description: Responsible for loading and drawing a background image
+//Description: Responsible for loading and drawing a background image.
+//			   The background is tiled horizontally into a cached strip that is
+//			   updated incrementally as the camera scrolls.
 
 
 #include <Graphics/Image.hpp>
@@ -16,8 +18,22 @@ public:
 
 	Background(const std::filesystem::path& path);
 
-	void draw(Graphics::Image& image, const Camera& camera) const;
+	void draw(Graphics::Image& image, const Camera& camera);
 
 private:
+	// Copy the columns [x0, x1) of the horizontally tiled background into the strip.
+	void updateStrip(int x0, int x1);
+
+	// The number of extra columns in the strip (in addition to the screen width),
+	// so the strip only needs to be updated every StripMargin pixels of scrolling.
+	static constexpr int StripMargin = 64;
+
 	std::shared_ptr<Graphics::Image> background;
-};
\ No newline at end of file
+
+	// A ring buffer of pre-composited background columns:
+	// column x of the tiled background is stored in column (x mod strip width) of the strip.
+	Graphics::Image strip;
+	// The columns of the tiled background that are currently stored in the strip.
+	int stripBegin = 0;
+	int stripEnd = 0;
+};
@@ -34,11 +34,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 			attackDmg = 1;
 			attackFrame = 2;
 
-			idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Idle.png", 123, 82, 0, 0, BlendMode::AlphaBlend), 7.f };
-			chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Chase.png", 123, 82, 0, 0, BlendMode::AlphaBlend), 8.f };
-			attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Atk.png", 123, 82, 0, 0, BlendMode::AlphaBlend), 10.f };
-			hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Hurt.png", 123, 82, 0, 0, BlendMode::AlphaBlend), 7.f };
-			deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Dead.png",123,82,0,0,BlendMode::AlphaBlend),4.f };
+			idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Idle.png", 123, 82, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+			chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Chase.png", 123, 82, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+			attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Atk.png", 123, 82, 0, 0, BlendMode::PremultipliedAlpha), 10.f };
+			hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Hurt.png", 123, 82, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+			deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Goblin_Dead.png",123,82,0,0,BlendMode::PremultipliedAlpha),4.f };
 
 			state = State::Idle;
 			transform.setAnchor(glm::vec2{ 71.0f,69.0f });
@@ -53,11 +53,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 			attackDmg = 1;
 			attackFrame = 2;
 
-			idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Idle.png", 110, 120, 0, 0, BlendMode::AlphaBlend), 7.f };
-			chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Chase.png", 110, 120, 0, 0, BlendMode::AlphaBlend), 8.f };
-			attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Atk.png", 110, 120, 0, 0, BlendMode::AlphaBlend), 11.f };
-			hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Hurt.png", 110, 120, 0, 0, BlendMode::AlphaBlend), 7.f };
-			deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Dead.png", 110, 120, 0, 0, BlendMode::AlphaBlend), 4.f };
+			idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Idle.png", 110, 120, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+			chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Chase.png", 110, 120, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+			attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Atk.png", 110, 120, 0, 0, BlendMode::PremultipliedAlpha), 11.f };
+			hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Hurt.png", 110, 120, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+			deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Skeleton_Dead.png", 110, 120, 0, 0, BlendMode::PremultipliedAlpha), 4.f };
 
 			state = State::Idle;
 			transform.setAnchor(glm::vec2{ 55.0f,99.0f });
@@ -74,11 +74,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 		attackDmg = 1;
 		attackFrame = 6;
 
-		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Idle.png", 116, 80, 0, 0, BlendMode::AlphaBlend), 7.f };
-		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Chase.png", 116, 80, 0, 0, BlendMode::AlphaBlend), 8.f };
-		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Atk.png", 116, 80, 0, 0, BlendMode::AlphaBlend), 11.f };
-		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Hurt.png", 116, 80, 0, 0, BlendMode::AlphaBlend), 7.f };
-		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Dead.png", 116, 80, 0, 0, BlendMode::AlphaBlend), 5.f };
+		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Idle.png", 116, 80, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Chase.png", 116, 80, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Atk.png", 116, 80, 0, 0, BlendMode::PremultipliedAlpha), 11.f };
+		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Hurt.png", 116, 80, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Golem_Dead.png", 116, 80, 0, 0, BlendMode::PremultipliedAlpha), 5.f };
 
 		state = State::Idle;
 		transform.setAnchor(glm::vec2{ 67.0f,77.0f });
@@ -93,11 +93,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 		attackDmg = 1;
 		attackFrame = 3;
 
-		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_IdleChase.png", 87, 78, 0, 0, BlendMode::AlphaBlend), 7.f };
-		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_IdleChase.png", 87, 78, 0, 0, BlendMode::AlphaBlend), 8.f };
-		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_Atk.png", 87, 78, 0, 0, BlendMode::AlphaBlend), 11.f };
-		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_Hurt.png", 87, 78, 0, 0, BlendMode::AlphaBlend), 7.f };
-		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_Dead.png", 87, 78, 0, 0, BlendMode::AlphaBlend), 5.f };
+		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_IdleChase.png", 87, 78, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_IdleChase.png", 87, 78, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_Atk.png", 87, 78, 0, 0, BlendMode::PremultipliedAlpha), 11.f };
+		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_Hurt.png", 87, 78, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Harpy_Dead.png", 87, 78, 0, 0, BlendMode::PremultipliedAlpha), 5.f };
 
 		state = State::Idle;
 		transform.setAnchor(glm::vec2{ 27.0f,60.0f });
@@ -112,11 +112,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 		attackDmg = 2;
 		attackFrame = 3;
 
-		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Idle.png", 89, 59, 0, 0, BlendMode::AlphaBlend), 7.f };
-		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Chase.png", 89, 59, 0, 0, BlendMode::AlphaBlend), 8.f };
-		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Atk.png", 89, 59, 0, 0, BlendMode::AlphaBlend), 11.f };
-		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Hurt.png", 89, 59, 0, 0, BlendMode::AlphaBlend), 7.f };
-		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Dead.png", 89, 59, 0, 0, BlendMode::AlphaBlend), 5.f };
+		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Idle.png", 89, 59, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Chase.png", 89, 59, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Atk.png", 89, 59, 0, 0, BlendMode::PremultipliedAlpha), 11.f };
+		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Hurt.png", 89, 59, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Centaur_Dead.png", 89, 59, 0, 0, BlendMode::PremultipliedAlpha), 5.f };
 
 		state = State::Idle;
 		transform.setAnchor(glm::vec2{ 57.0f,55.0f });
@@ -131,11 +131,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 		attackDmg = 2;
 		attackFrame = 3;
 
-		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Idle.png", 125, 115, 0, 0, BlendMode::AlphaBlend), 7.f };
-		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Chase.png", 125, 115, 0, 0, BlendMode::AlphaBlend), 8.f };
-		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Atk.png",125, 115, 0, 0, BlendMode::AlphaBlend), 11.f };
-		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Hurt.png", 125, 115, 0, 0, BlendMode::AlphaBlend), 7.f };
-		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Dead.png", 125, 115, 0, 0, BlendMode::AlphaBlend), 5.f };
+		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Idle.png", 125, 115, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Chase.png", 125, 115, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Atk.png",125, 115, 0, 0, BlendMode::PremultipliedAlpha), 11.f };
+		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Hurt.png", 125, 115, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Gargoyle_Dead.png", 125, 115, 0, 0, BlendMode::PremultipliedAlpha), 5.f };
 
 		state = State::Idle;
 		transform.setAnchor(glm::vec2{ 62.0f,102.0f });
@@ -150,11 +150,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 		attackDmg = 3;
 		attackFrame = 3;
 
-		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Idle.png", 96, 61, 0, 0, BlendMode::AlphaBlend), 7.f };
-		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Chase.png", 96, 61, 0, 0, BlendMode::AlphaBlend), 8.f };
-		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Atk.png",96, 61, 0, 0, BlendMode::AlphaBlend), 11.f };
-		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Hurt.png", 96, 61, 0, 0, BlendMode::AlphaBlend), 7.f };
-		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Dead.png", 96, 61, 0, 0, BlendMode::AlphaBlend), 5.f };
+		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Idle.png", 96, 61, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Chase.png", 96, 61, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Atk.png",96, 61, 0, 0, BlendMode::PremultipliedAlpha), 11.f };
+		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Hurt.png", 96, 61, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/Cerberus_Dead.png", 96, 61, 0, 0, BlendMode::PremultipliedAlpha), 5.f };
 
 		state = State::Idle;
 		transform.setAnchor(glm::vec2{ 49.0f,56.0f });
@@ -169,11 +169,11 @@ Enemy::Enemy(const glm::vec2& pos,Type _type)
 		attackDmg = 3;
 		attackFrame = 5;
 
-		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_IdleChase.png", 108, 117, 0, 0, BlendMode::AlphaBlend), 7.f };
-		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_IdleChase.png", 108, 117, 0, 0, BlendMode::AlphaBlend), 8.f };
-		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_Atk.png",108, 117, 0, 0, BlendMode::AlphaBlend), 11.f };
-		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_Hurt.png", 108, 117, 0, 0, BlendMode::AlphaBlend), 7.f };
-		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_Dead.png", 108, 117, 0, 0, BlendMode::AlphaBlend), 5.f };
+		idleAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_IdleChase.png", 108, 117, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		chaseAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_IdleChase.png", 108, 117, 0, 0, BlendMode::PremultipliedAlpha), 8.f };
+		attackAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_Atk.png",108, 117, 0, 0, BlendMode::PremultipliedAlpha), 11.f };
+		hurtAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_Hurt.png", 108, 117, 0, 0, BlendMode::PremultipliedAlpha), 7.f };
+		deadAnim = SpriteAnim{ ResourceManager::loadSpriteSheet("assets/textures/FlyingEye_Dead.png", 108, 117, 0, 0, BlendMode::PremultipliedAlpha), 5.f };
 
 		state = State::Idle;
 		transform.setAnchor(glm::vec2{ 43.0f,89.0f });
@@ -36,6 +36,9 @@ public:
 	};
 	Level(Graphics::Window& _window);
 
+	//Convert the textures to cooked textures that load without decoding
+	static void cookAssets();
+
 	void loadLevelAssets();
 	void setLevel(int levelNumber);
 
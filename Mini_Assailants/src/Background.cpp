@@ -2,23 +2,95 @@
 
 #include <Graphics/ResourceManager.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace Graphics;
 
+namespace
+{
+	// Modulo that is always positive.
+	int wrap(int x, int n)
+	{
+		const int m = x % n;
+		return m < 0 ? m + n : m;
+	}
+}
+
 Background::Background(const std::filesystem::path& path)
 {
 	background = ResourceManager::loadImage(path);
 }
 
-void Background::draw(Image& image, const Camera& camera) const
+void Background::draw(Image& image, const Camera& camera)
+{
+    const int screenWidth = static_cast<int>(image.getWidth());
+    const int stripWidth = screenWidth + StripMargin;
+
+    // The column of the tiled background that is visible at the left edge of the screen.
+    const int left = -static_cast<int>(camera.getViewPosition().x);
+    const int right = left + screenWidth;
+
+    if (strip.getWidth() != static_cast<uint32_t>(stripWidth) || strip.getHeight() != background->getHeight())
+    {
+        strip.resize(stripWidth, background->getHeight());
+        stripBegin = stripEnd = 0;
+    }
+
+    // Advance the strip if the visible columns are not in the strip.
+    // The margin is placed in the direction the camera is moving.
+    if (left < stripBegin || right > stripEnd)
+    {
+        const int begin = left < stripBegin ? right - stripWidth : left;
+        const int end = begin + stripWidth;
+
+        // Only copy the columns that were not in the strip yet.
+        if (end <= stripBegin || begin >= stripEnd)
+        {
+            updateStrip(begin, end);
+        }
+        else if (begin < stripBegin)
+        {
+            updateStrip(begin, stripBegin);
+        }
+        else
+        {
+            updateStrip(stripEnd, end);
+        }
+
+        stripBegin = begin;
+        stripEnd = end;
+    }
+
+    // Draw the visible columns of the ring buffer (in at most two parts, the screen clips the rest).
+    const int x = wrap(left, stripWidth);
+
+    image.copy(strip, -x, 0);
+    if (stripWidth - x < screenWidth)
+        image.copy(strip, stripWidth - x, 0);
+}
+
+void Background::updateStrip(int x0, int x1)
 {
-    float w = background->getWidth();
+    const Image& src = *background;
+    const int backgroundWidth = static_cast<int>(src.getWidth());
+    const int stripWidth = static_cast<int>(strip.getWidth());
+    const uint32_t height = src.getHeight();
+
+    // Get the pixels once: the background is only read, and the strip changes once per update.
+    const Color* srcPixels = src.data();
+    Color* dstPixels = strip.data();
+
+    // Copy the columns in runs that don't wrap around the background or the strip.
+    for (int x = x0; x < x1;)
+    {
+        const int srcX = wrap(x, backgroundWidth);
+        const int dstX = wrap(x, stripWidth);
+        const int n = std::min({ x1 - x, backgroundWidth - srcX, stripWidth - dstX });
 
-    // Calculate the current position of the background.
-    float bgX = camera.getViewPosition().x;
+        for (uint32_t y = 0; y < height; ++y)
+            std::memcpy(dstPixels + static_cast<size_t>(y) * stripWidth + dstX, srcPixels + static_cast<size_t>(y) * backgroundWidth + srcX, n * sizeof(Color));
 
-    // Draw the background repeatedly to the right as the player moves.
-    while (bgX < image.getWidth()) {
-        image.copy(*background, glm::vec2(bgX, 0));
-        bgX += w;
+        x += n;
     }
 }
@@ -11,6 +11,8 @@ Game::Game(int width, int height, Window& _window)
 {
 	level.setLevel(1);
 	image.resize(width, height);
+	// Only redraw the screen tiles that change between frames (static menus and overlays are retained).
+	image.setDirtyTracking(true);
 }
 
 void Game::play()
@@ -35,8 +37,12 @@ void Game::play()
     Input::update();
 
     level.update(timer.elapsedSeconds());
+
+    // Record the frame's draw calls and rasterize them per screen tile.
+    image.beginDeferred();
     level.draw(image);
     image.drawText(Font::Default, fps, 407, 5, Color::Yellow);
+    image.endDeferred();
 }
 
 void Game::processEvent(const Event& e) {
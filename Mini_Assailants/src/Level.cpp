@@ -12,6 +12,36 @@
 using namespace Graphics;
 using namespace Math;
 
+// The textures that are used with straight alpha.
+static const std::filesystem::path straightTextures[] = {
+    "assets/textures/startScreen.png", "assets/textures/helpScreen.png",
+    "assets/textures/play_btn_sheet.png", "assets/textures/quit_btn_sheet.png", "assets/textures/help_btn_sheet.png", "assets/textures/back_btn_sheet.png",
+    "assets/textures/lvl1_btn_sheet.png", "assets/textures/lvl2_btn_sheet.png", "assets/textures/lvl3_btn_sheet.png",
+    "assets/textures/stage1.png", "assets/textures/stage2.png", "assets/textures/stage3.png",
+    "assets/textures/hp_potion.png", "assets/textures/mp_potion.png", "assets/textures/coin.png",
+};
+
+// The sprite sheets of the player and the enemies use premultiplied alpha.
+static const std::filesystem::path premultipliedTextures[] = {
+    "assets/textures/Coin_Sheet.png",
+    "assets/textures/Idle_Sheet.png", "assets/textures/Walking_Sheet.png", "assets/textures/LightAtk1_Sheet.png", "assets/textures/LightAtk2_Sheet.png",
+    "assets/textures/HeavyAtk1_Sheet.png", "assets/textures/HeavyAtk2_Sheet.png", "assets/textures/Special1_Sheet.png", "assets/textures/Special2_Sheet.png",
+    "assets/textures/Goblin_Idle.png", "assets/textures/Goblin_Chase.png", "assets/textures/Goblin_Atk.png", "assets/textures/Goblin_Hurt.png", "assets/textures/Goblin_Dead.png",
+    "assets/textures/Skeleton_Idle.png", "assets/textures/Skeleton_Chase.png", "assets/textures/Skeleton_Atk.png", "assets/textures/Skeleton_Hurt.png", "assets/textures/Skeleton_Dead.png",
+    "assets/textures/Golem_Idle.png", "assets/textures/Golem_Chase.png", "assets/textures/Golem_Atk.png", "assets/textures/Golem_Hurt.png", "assets/textures/Golem_Dead.png",
+    "assets/textures/Harpy_IdleChase.png", "assets/textures/Harpy_Atk.png", "assets/textures/Harpy_Hurt.png", "assets/textures/Harpy_Dead.png",
+    "assets/textures/Centaur_Idle.png", "assets/textures/Centaur_Chase.png", "assets/textures/Centaur_Atk.png", "assets/textures/Centaur_Hurt.png", "assets/textures/Centaur_Dead.png",
+    "assets/textures/Gargoyle_Idle.png", "assets/textures/Gargoyle_Chase.png", "assets/textures/Gargoyle_Atk.png", "assets/textures/Gargoyle_Hurt.png", "assets/textures/Gargoyle_Dead.png",
+    "assets/textures/Cerberus_Idle.png", "assets/textures/Cerberus_Chase.png", "assets/textures/Cerberus_Atk.png", "assets/textures/Cerberus_Hurt.png", "assets/textures/Cerberus_Dead.png",
+    "assets/textures/FlyingEye_IdleChase.png", "assets/textures/FlyingEye_Atk.png", "assets/textures/FlyingEye_Hurt.png", "assets/textures/FlyingEye_Dead.png",
+};
+
+void Level::cookAssets()
+{
+    ResourceManager::cookImages(straightTextures);
+    ResourceManager::cookImages(premultipliedTextures, true);
+}
+
 Level::Level(Window& _window)
 	: window{ _window },
       gameState{GameState::Menu},
@@ -39,6 +69,10 @@ Level::Level(Window& _window)
     bgm3.setVolume(0.1f);
     bgm3.setLooping(true);
 
+    // Decode the textures on all cores before they are used.
+    ResourceManager::preload(straightTextures);
+    ResourceManager::preload(premultipliedTextures, true);
+
     startScreen = ResourceManager::loadImage("assets/textures/startScreen.png");
 	helpScreen = Sprite(ResourceManager::loadImage("assets/textures/helpScreen.png"), BlendMode::AlphaBlend);
 
@@ -71,7 +105,7 @@ Level::Level(Window& _window)
     }
 
     //Ui
-    const auto coinSheet = ResourceManager::loadSpriteSheet("assets/textures/Coin_Sheet.png", 20, 20, 0, 0, BlendMode::AlphaBlend);
+    const auto coinSheet = ResourceManager::loadSpriteSheet("assets/textures/Coin_Sheet.png", 20, 20, 0, 0, BlendMode::PremultipliedAlpha);
     coinUiAnim = SpriteAnim{ coinSheet, 10.0f };
 }
 
@@ -111,6 +145,9 @@ void Level::loadLevelAssets()
     }
 
     player.setCoins(coinsCollected);
+
+    // Pack the sprites of the player and the enemies into a texture atlas.
+    ResourceManager::packSpriteSheets();
 }
 
 void Level::setLevel(int levelNumber)
@@ -215,8 +252,7 @@ void Level::draw(Image& image)
         {
             lvlbtn.draw(image);
         }
-        image.drawText(tafelSans, "LEVEL SELECT:", glm::vec2{ 103,238 }, Color::Black);
-        image.drawText(tafelSans, "LEVEL SELECT:", glm::vec2{ 103,235 }, {230,157,107});
+        image.drawTextShadow(tafelSans, "LEVEL SELECT:", glm::vec2{ 103,235 }, {230,157,107}, Color::Black, { 0, 3 });
         break;
     case GameState::HelpScreen:
         image.drawSprite(helpScreen,{0,0});
@@ -237,8 +273,7 @@ void Level::draw(Image& image)
         //GO text
         if (goTextTimer > 0.0f)
         {
-            image.drawText(tafelSans, "GO->", glm::vec2{ SCREEN_WIDTH - 48, SCREEN_HEIGHT / 2 + 2 }, Color::Black);
-            image.drawText(tafelSans, "GO->", glm::vec2{ SCREEN_WIDTH - 50, SCREEN_HEIGHT / 2 }, Color::Yellow);
+            image.drawTextShadow(tafelSans, "GO->", glm::vec2{ SCREEN_WIDTH - 50, SCREEN_HEIGHT / 2 }, Color::Yellow, Color::Black, { 2, 2 });
         }
 
         // Ui Coin
@@ -273,8 +308,7 @@ void Level::draw(Image& image)
         image.drawText(tafelSans, "Game Over, press Enter to Continue", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 + 3.5f }, Color::Black);
         image.drawText(tafelSans, "Game Over, press Enter to Continue", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 }, Color::Red);
 
-        image.drawText(tafelSans, "Collected " + std::to_string(player.getCoins()) + " coins", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 + 23.f }, Color::Black);
-        image.drawText(tafelSans, "Collected " + std::to_string(player.getCoins()) + " coins", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 + 20.f }, Color::Yellow);
+        image.drawTextShadow(tafelSans, "Collected " + std::to_string(player.getCoins()) + " coins", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 + 20.f }, Color::Yellow, Color::Black, { 0, 3 });
         break;
     case GameState::Win:
         background.draw(image, camera);
@@ -286,14 +320,11 @@ void Level::draw(Image& image)
             winText = "Congrats on clearing level " + std::to_string(currentLevel);
 			winText2 = "Press Enter to go to next level";
         }
-        image.drawText(tafelSans, winText, glm::vec2{ SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 + 3.5f }, Color::Black);
-        image.drawText(tafelSans, winText, glm::vec2{ SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 }, Color::Green);
+        image.drawTextShadow(tafelSans, winText, glm::vec2{ SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 }, Color::Green, Color::Black, { 0, 3 });
 
-        image.drawText(tafelSans, winText2, glm::vec2{ SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 + 23.5f }, Color::Black);
-        image.drawText(tafelSans, winText2, glm::vec2{ SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 + 20.f }, Color::Green);
+        image.drawTextShadow(tafelSans, winText2, glm::vec2{ SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 + 20.f }, Color::Green, Color::Black, { 0, 3 });
 
-        image.drawText(tafelSans, "Collected " + std::to_string(player.getCoins()) + " coins", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 + 43.f }, Color::Black);
-        image.drawText(tafelSans, "Collected " + std::to_string(player.getCoins()) + " coins", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 + 40.f }, Color::Yellow);
+        image.drawTextShadow(tafelSans, "Collected " + std::to_string(player.getCoins()) + " coins", glm::vec2{ SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 + 40.f }, Color::Yellow, Color::Black, { 0, 3 });
         break;
     }
 }
@@ -44,30 +44,30 @@ Player::Player(const glm::vec2& pos)
 	specialAtk2SFX.setVolume(0.1f);
 
 	//Sprites
-	const auto idleSheet = ResourceManager::loadSpriteSheet("assets/textures/Idle_Sheet.png", 153, 127, 0, 0, BlendMode::AlphaBlend);
+	const auto idleSheet = ResourceManager::loadSpriteSheet("assets/textures/Idle_Sheet.png", 153, 127, 0, 0, BlendMode::PremultipliedAlpha);
 	idleSprite = SpriteAnim{ idleSheet, 10.0f };
 
-	const auto walkSheet = ResourceManager::loadSpriteSheet("assets/textures/Walking_Sheet.png", 153, 127, 0, 0, BlendMode::AlphaBlend);
+	const auto walkSheet = ResourceManager::loadSpriteSheet("assets/textures/Walking_Sheet.png", 153, 127, 0, 0, BlendMode::PremultipliedAlpha);
 	walkSprite = SpriteAnim{ walkSheet, 10.0f };
 
 	// 2 anims for Light Attack (On pressing H key)
-	const auto lightAtk1Sheet = ResourceManager::loadSpriteSheet("assets/textures/LightAtk1_Sheet.png", 153,			                                                                  127, 0, 0, BlendMode::AlphaBlend);
+	const auto lightAtk1Sheet = ResourceManager::loadSpriteSheet("assets/textures/LightAtk1_Sheet.png", 153,			                                                                  127, 0, 0, BlendMode::PremultipliedAlpha);
 	lightAtk1Sprite = SpriteAnim{ lightAtk1Sheet, 13.5f };
 
-	const auto lightAtk2Sheet = ResourceManager::loadSpriteSheet("assets/textures/LightAtk2_Sheet.png", 153,                                                                        127, 0, 0, BlendMode::AlphaBlend);
+	const auto lightAtk2Sheet = ResourceManager::loadSpriteSheet("assets/textures/LightAtk2_Sheet.png", 153,                                                                        127, 0, 0, BlendMode::PremultipliedAlpha);
 	lightAtk2Sprite = SpriteAnim{ lightAtk2Sheet, 15.0f };
 
 	//2 anims for Heavy Attack (On pressing J key)
-	const auto heavyAtk1Sheet = ResourceManager::loadSpriteSheet("assets/textures/HeavyAtk1_Sheet.png", 153, 127, 0, 0, BlendMode::AlphaBlend);
+	const auto heavyAtk1Sheet = ResourceManager::loadSpriteSheet("assets/textures/HeavyAtk1_Sheet.png", 153, 127, 0, 0, BlendMode::PremultipliedAlpha);
 	heavyAtk1Sprite = SpriteAnim{ heavyAtk1Sheet, 13.5f };
 
-	const auto heavyAtk2Sheet = ResourceManager::loadSpriteSheet("assets/textures/HeavyAtk2_Sheet.png", 153, 127, 0, 0, BlendMode::AlphaBlend);
+	const auto heavyAtk2Sheet = ResourceManager::loadSpriteSheet("assets/textures/HeavyAtk2_Sheet.png", 153, 127, 0, 0, BlendMode::PremultipliedAlpha);
 	heavyAtk2Sprite = SpriteAnim{ heavyAtk2Sheet, 15.0f };
 
-	const auto special1Sheet = ResourceManager::loadSpriteSheet("assets/textures/Special1_Sheet.png", 153,                                                                                 127, 0, 0, BlendMode::AlphaBlend);
+	const auto special1Sheet = ResourceManager::loadSpriteSheet("assets/textures/Special1_Sheet.png", 153,                                                                                 127, 0, 0, BlendMode::PremultipliedAlpha);
 	special1Sprite = SpriteAnim{ special1Sheet, 15.0f };
 
-	const auto special2Sheet = ResourceManager::loadSpriteSheet("assets/textures/Special2_Sheet.png", 153, 127, 0, 0, BlendMode::AlphaBlend);
+	const auto special2Sheet = ResourceManager::loadSpriteSheet("assets/textures/Special2_Sheet.png", 153, 127, 0, 0, BlendMode::PremultipliedAlpha);
 	special2Sprite = SpriteAnim{ special2Sheet, 13.0f };
 
 	attackDmg[AttackType::Light1] = 1;
@@ -1,5 +1,7 @@
 #include<UiBar.hpp>
 
+#include <algorithm>
+
 UiBar::UiBar(float _width, float _height, const glm::vec2& _offset)
 	:width{ _width }, height{ _height }, offset{ _offset }
 {
@@ -9,15 +11,16 @@ UiBar::UiBar(float _width, float _height, const glm::vec2& _offset)
 void UiBar::Draw(Graphics::Image& image, float currentValue, float maxValue, const glm::vec2& position, const Graphics::Color& color) const
 {
 	const float valuePercent = currentValue / maxValue;
-	Math::AABB barAABB;
+	const glm::vec2 min = position + offset;
+	const float fill = std::clamp(valuePercent, 0.0f, 1.0f) * width;
 
-	//Outline
-	barAABB.min = glm::vec3{ position + offset - glm::vec2{1,1}, 0 };
-	barAABB.max = glm::vec3{ position + offset + glm::vec2{ width + 2, height + 2 }, 0 };
-	image.drawAABB(barAABB, Graphics::Color::Black);
+	//Value
+	image.drawAABB(Math::AABB::fromMinMax({ min, 0 }, { min + glm::vec2{ fill, height }, 0 }), color);
 
-	barAABB.min = glm::vec3{position + offset, 0};
-	barAABB.max = glm::vec3{ position + offset + glm::vec2{ valuePercent * width, height }, 0 };
-	image.drawAABB(barAABB, color );
+	//Outline and the empty part of the bar (drawn around the value, so no pixel is filled twice)
+	image.drawAABB(Math::AABB::fromMinMax({ min - glm::vec2{ 1, 1 }, 0 }, { min + glm::vec2{ width + 2, -1 }, 0 }), Graphics::Color::Black);
+	image.drawAABB(Math::AABB::fromMinMax({ min + glm::vec2{ -1, height + 1 }, 0 }, { min + glm::vec2{ width + 2, height + 2 }, 0 }), Graphics::Color::Black);
+	image.drawAABB(Math::AABB::fromMinMax({ min + glm::vec2{ -1, 0 }, 0 }, { min + glm::vec2{ -1, height }, 0 }), Graphics::Color::Black);
+	image.drawAABB(Math::AABB::fromMinMax({ min + glm::vec2{ fill + 1, 0 }, 0 }, { min + glm::vec2{ width + 2, height }, 0 }), Graphics::Color::Black);
 }
 
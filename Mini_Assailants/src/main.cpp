@@ -11,15 +11,25 @@
 
 #include <Game.hpp>
 #include <Constants.hpp>
+#include <Level.hpp>
 
 #include "Graphics/Window.hpp"
 
 #include <iostream>
+#include <string_view>
 
 using namespace Graphics;
 
-int main()
+int main(int argc, char* argv[])
 {
+	//Cook the textures and exit: mini_assailants --cook
+	if (argc > 1 && std::string_view{ argv[1] } == "--cook")
+	{
+		std::cout << "...Cooking Assets" << '\n';
+		Level::cookAssets();
+		return 0;
+	}
+
 	std::cout << "...Loading Game" << '\n'; 
 
 	Window window{ L"Mini Assailants", SCREEN_WIDTH, SCREEN_HEIGHT };
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Enums.hpp"
+#include "aligned_unique_ptr.hpp"
+
+#include <Math/Rect.hpp>
+
+#include <cassert>
+#include <cstdint>
+
+namespace Graphics
+{
+class Image;
+
+/// <summary>
+/// An image that only stores an 8-bit alpha (coverage) value per pixel.
+/// Used for font images, text masks, and other masks that don't need color:
+/// it uses a quarter of the memory (and memory bandwidth) of a 32-bit image.
+/// Use <see cref="Image::drawMask"/> to draw an alpha image in a color.
+/// </summary>
+class SR_API AlphaImage final
+{
+public:
+    /// <summary>
+    /// Default construct an alpha image.
+    /// The image is 0x0 with no buffer.
+    /// </summary>
+    AlphaImage() = default;
+
+    /// <summary>
+    /// Construct an alpha image from an initial width and height.
+    /// </summary>
+    /// <param name="width">The image width (in pixels).</param>
+    /// <param name="height">The image height (in pixels).</param>
+    AlphaImage( uint32_t width, uint32_t height );
+
+    /// <summary>
+    /// Construct an alpha image from the alpha channel of an image.
+    /// </summary>
+    /// <param name="image">The image to take the alpha channel from.</param>
+    explicit AlphaImage( const Image& image );
+
+    AlphaImage( const AlphaImage& copy );
+    AlphaImage( AlphaImage&& move ) noexcept;
+    ~AlphaImage() = default;
+
+    AlphaImage& operator=( const AlphaImage& image );
+    AlphaImage& operator=( AlphaImage&& image ) noexcept;
+
+    /// <summary>
+    /// Check if this is a valid image.
+    /// </summary>
+    explicit operator bool() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+    /// <summary>
+    /// Resize this image.
+    /// Note: Does nothing if the image is already the requested size.
+    /// </summary>
+    /// <param name="width">The new image width (in pixels).</param>
+    /// <param name="height">The new image height (in pixels).</param>
+    void resize( uint32_t width, uint32_t height );
+
+    /// <summary>
+    /// Set all pixels of the image to the same alpha value.
+    /// </summary>
+    /// <param name="alpha">The alpha value to clear the image to.</param>
+    void clear( uint8_t alpha = 0u ) noexcept;
+
+    /// <summary>
+    /// Combine a region of another alpha image into this image.
+    /// Each pixel becomes the maximum of the source and destination alpha,
+    /// so overlapping masks (like neighboring glyphs) don't cut into each other.
+    /// </summary>
+    /// <param name="srcImage">The alpha image to copy from.</param>
+    /// <param name="srcRect">The region of the source image to copy.</param>
+    /// <param name="x">The x-coordinate of the top-left corner of the region in this image.</param>
+    /// <param name="y">The y-coordinate of the top-left corner of the region in this image.</param>
+    /// <param name="step">(optional) The horizontal distance between the source pixels that are copied (used for oversampled glyphs).
+    /// The region is copied to (srcRect.width + step - 1) / step columns of this image. Default: 1.</param>
+    void blit( const AlphaImage& srcImage, const Math::RectI& srcRect, int x, int y, int step = 1 ) noexcept;
+
+    /// <summary>
+    /// Sample the image at integer coordinates.
+    /// </summary>
+    /// <param name="u">The U texture coordinate.</param>
+    /// <param name="v">The V texture coordinate.</param>
+    /// <param name="addressMode">Determines how to apply out-of-bounds texture coordinates.</param>
+    /// <returns>The alpha value of the texel at the given UV coordinates.</returns>
+    uint8_t sample( int u, int v, AddressMode addressMode = AddressMode::Wrap ) const noexcept;
+
+    /// <summary>
+    /// Sample the image at integer coordinates with an address mode that is known at compile time.
+    /// </summary>
+    /// <typeparam name="A">Determines how to apply out-of-bounds texture coordinates.</typeparam>
+    /// <param name="u">The U texture coordinate.</param>
+    /// <param name="v">The V texture coordinate.</param>
+    /// <returns>The alpha value of the texel at the given UV coordinates.</returns>
+    template<AddressMode A>
+    uint8_t sample( int u, int v ) const noexcept;
+
+    uint8_t operator()( uint32_t x, uint32_t y ) const
+    {
+        assert( x < m_width );
+        assert( y < m_height );
+
+        return m_data[static_cast<uint64_t>( y ) * m_width + x];
+    }
+
+    uint8_t& operator()( uint32_t x, uint32_t y )
+    {
+        assert( x < m_width );
+        assert( y < m_height );
+
+        m_generation = nextGeneration();
+
+        return m_data[static_cast<uint64_t>( y ) * m_width + x];
+    }
+
+    uint32_t getWidth() const noexcept
+    {
+        return m_width;
+    }
+
+    uint32_t getHeight() const noexcept
+    {
+        return m_height;
+    }
+
+    Math::RectI getRect() const noexcept
+    {
+        return { 0, 0, static_cast<int>( m_width ), static_cast<int>( m_height ) };
+    }
+
+    /// <summary>
+    /// Get the generation of the pixels of this image.
+    /// The generation changes every time the pixels of the image can change, and no two alpha images share a generation.
+    /// Deferred draw calls compare the generation of the masks they reference to find out if the masks changed.
+    /// </summary>
+    /// <returns>The generation of the pixels of this image.</returns>
+    uint64_t getGeneration() const noexcept
+    {
+        return m_generation;
+    }
+
+    /// <summary>
+    /// Get a pointer to the pixel buffer.
+    /// Note: The generation of the image changes, since the pixels can be changed through the pointer.
+    /// </summary>
+    uint8_t* data() noexcept
+    {
+        m_generation = nextGeneration();
+        return m_data.get();
+    }
+
+    /// <summary>
+    /// Get a read-only pointer to the pixel buffer.
+    /// </summary>
+    const uint8_t* data() const noexcept
+    {
+        return m_data.get();
+    }
+
+private:
+    // Get a new (globally unique) generation for an alpha image whose pixels can change.
+    static uint64_t nextGeneration() noexcept;
+
+    uint32_t                      m_width  = 0u;
+    uint32_t                      m_height = 0u;
+    aligned_unique_ptr<uint8_t[]> m_data;
+    // Changes whenever the pixels can change (see getGeneration).
+    uint64_t m_generation = nextGeneration();
+};
+
+}  // namespace Graphics
@@ -3,6 +3,8 @@
 #include "Color.hpp"
 #include "Config.hpp"
 
+#include <cstddef>
+
 namespace Graphics
 {
 
@@ -42,6 +44,20 @@ enum class BlendFactor
     SrcAlphaSat,       ///< Multiply the pixel operand by min( As, 1 - Ad ) before applying the blend operation.
 };
 
+/// <summary>
+/// The preset blend modes that have specialized (SIMD) implementations.
+/// Any other blend mode is Custom.
+/// </summary>
+enum class BlendPreset
+{
+    Disable,             ///< Blending is disabled (BlendMode::Disable).
+    AlphaBlend,          ///< BlendMode::AlphaBlend
+    AdditiveBlend,       ///< BlendMode::AdditiveBlend
+    SubtractiveBlend,    ///< BlendMode::SubtractiveBlend
+    PremultipliedAlpha,  ///< BlendMode::PremultipliedAlpha
+    Custom               ///< Any other blend mode.
+};
+
 struct SR_API BlendMode
 {
     /// <summary>
@@ -109,10 +125,24 @@ struct SR_API BlendMode
     /// <returns></returns>
     constexpr Color Blend( const Color& srcColor, const Color& dstColor ) const noexcept;
 
+    constexpr bool operator==( const BlendMode& ) const noexcept = default;
+
+    /// <summary>
+    /// Get the preset that matches this blend mode.
+    /// </summary>
+    /// <returns>The preset of this blend mode, or BlendPreset::Custom if this is not one of the preset blend modes.</returns>
+    BlendPreset getPreset() const noexcept;
+
     static const BlendMode Disable;
     static const BlendMode AlphaBlend;
     static const BlendMode AdditiveBlend;
     static const BlendMode SubtractiveBlend;
+
+    /// <summary>
+    /// Alpha blending for source pixels that are already multiplied by their alpha ( s + d * ( 1 - As ) ).
+    /// Use this blend mode for images that are converted with <see cref="Image::premultiplyAlpha"/>.
+    /// </summary>
+    static const BlendMode PremultipliedAlpha;
 };
 
 /// <summary>
@@ -238,4 +268,99 @@ constexpr Color BlendMode::Blend( const Color& srcColor, const Color& dstColor )
     return { RGB.r, RGB.g, RGB.b, A };
 }
 
+/// <summary>
+/// Blend a single pixel using a blend preset that is known at compile time.
+/// The result is the same as BlendMode::Blend.
+/// </summary>
+/// <typeparam name="P">The preset of the blend mode.</typeparam>
+/// <param name="srcColor">The source color.</param>
+/// <param name="dstColor">The destination color.</param>
+/// <param name="blendMode">The blend mode (only used for BlendPreset::Custom).</param>
+/// <returns>The blended color.</returns>
+template<BlendPreset P>
+constexpr Color blendPixel( const Color& srcColor, const Color& dstColor, const BlendMode& blendMode ) noexcept
+{
+    if constexpr ( P == BlendPreset::Disable )
+    {
+        return srcColor;
+    }
+    else if constexpr ( P == BlendPreset::AlphaBlend )
+    {
+        const int a    = srcColor.a;
+        const int invA = 255 - a;
+
+        return {
+            static_cast<uint8_t>( srcColor.r * a / 255 + dstColor.r * invA / 255 ),
+            static_cast<uint8_t>( srcColor.g * a / 255 + dstColor.g * invA / 255 ),
+            static_cast<uint8_t>( srcColor.b * a / 255 + dstColor.b * invA / 255 ),
+            srcColor.a
+        };
+    }
+    else if constexpr ( P == BlendPreset::PremultipliedAlpha )
+    {
+        // The source color is already multiplied by the source alpha.
+        const int invA = 255 - srcColor.a;
+
+        return {
+            static_cast<uint8_t>( std::min( srcColor.r + dstColor.r * invA / 255, 255 ) ),
+            static_cast<uint8_t>( std::min( srcColor.g + dstColor.g * invA / 255, 255 ) ),
+            static_cast<uint8_t>( std::min( srcColor.b + dstColor.b * invA / 255, 255 ) ),
+            srcColor.a
+        };
+    }
+    else if constexpr ( P == BlendPreset::AdditiveBlend || P == BlendPreset::SubtractiveBlend )
+    {
+        // The preset blend modes keep the source alpha.
+        const Color RGB = P == BlendPreset::AdditiveBlend ? srcColor + dstColor : srcColor - dstColor;
+        return RGB.withAlpha( srcColor.a );
+    }
+    else
+    {
+        return blendMode.Blend( srcColor, dstColor );
+    }
+}
+
+/// <summary>
+/// Blend a span of source pixels into a span of destination pixels using a blend preset that is known at compile time.
+/// </summary>
+/// <typeparam name="P">The preset of the blend mode.</typeparam>
+/// <param name="dst">The destination pixels.</param>
+/// <param name="src">The source pixels.</param>
+/// <param name="count">The number of pixels to blend.</param>
+/// <param name="blendMode">The blend mode (only used for BlendPreset::Custom).</param>
+template<BlendPreset P>
+SR_API void blendSpan( Color* dst, const Color* src, size_t count, const BlendMode& blendMode ) noexcept;
+
+/// <summary>
+/// Blend a single color into a span of destination pixels using a blend preset that is known at compile time.
+/// </summary>
+/// <typeparam name="P">The preset of the blend mode.</typeparam>
+/// <param name="dst">The destination pixels.</param>
+/// <param name="src">The source color.</param>
+/// <param name="count">The number of pixels to blend.</param>
+/// <param name="blendMode">The blend mode (only used for BlendPreset::Custom).</param>
+template<BlendPreset P>
+SR_API void blendSpan( Color* dst, const Color& src, size_t count, const BlendMode& blendMode ) noexcept;
+
+/// <summary>
+/// Blend a span of source pixels into a span of destination pixels.
+/// The preset blend modes (Disable, AlphaBlend, AdditiveBlend, SubtractiveBlend, and PremultipliedAlpha) are blended
+/// several pixels at a time using SIMD (AVX2 if available, SSE2 otherwise). Other blend modes
+/// fall back to BlendMode::Blend for each pixel. The result is the same as calling BlendMode::Blend for each pixel.
+/// </summary>
+/// <param name="dst">The destination pixels.</param>
+/// <param name="src">The source pixels.</param>
+/// <param name="count">The number of pixels to blend.</param>
+/// <param name="blendMode">The blend mode to apply.</param>
+SR_API void blendSpan( Color* dst, const Color* src, size_t count, const BlendMode& blendMode ) noexcept;
+
+/// <summary>
+/// Blend a single color into a span of destination pixels.
+/// </summary>
+/// <param name="dst">The destination pixels.</param>
+/// <param name="src">The source color.</param>
+/// <param name="count">The number of pixels to blend.</param>
+/// <param name="blendMode">The blend mode to apply.</param>
+SR_API void blendSpan( Color* dst, const Color& src, size_t count, const BlendMode& blendMode ) noexcept;
+
 }  // namespace Graphics
\ No newline at end of file
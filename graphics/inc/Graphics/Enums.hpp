@@ -25,4 +25,15 @@ enum class FillMode
     Solid       ///< Polygons interiors are filled.
 };
 
+/// <summary>
+/// GlyphMode determines how the glyphs of a font are stored and drawn.
+/// * GlyphMode::Bitmap: Glyphs are rasterized at the size of the font and copied to the image.
+/// * GlyphMode::DistanceField: Glyphs are stored as signed distance fields at a fixed size and can be drawn at any size.
+/// </summary>
+enum class GlyphMode
+{
+    Bitmap,        ///< Glyphs are coverage masks at the size of the font.
+    DistanceField  ///< Glyphs are signed distance fields that are scaled to the size of the font.
+};
+
 }
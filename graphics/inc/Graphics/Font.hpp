@@ -2,51 +2,139 @@
 
 #include "Color.hpp"
 #include "Config.hpp"
+#include "Enums.hpp"
+
+#include <Math/Rect.hpp>
 
 #include <glm/vec2.hpp>
 #include <stb_truetype.h>
 
 #include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 namespace Graphics
 {
+class AlphaImage;
+class GlyphAtlas;
 class Image;
+class TextCache;
+struct TextRun;
 
+/// <summary>
+/// Text is rasterized once per string into a coverage mask (a text run) that is cached by the font.
+/// Drawing the same string again (in any color) only blits the cached mask.
+/// Fonts with distance field glyphs cache the distance field of the text instead, which is drawn at the size of the font
+/// and can be drawn with an outline and a shadow in a single pass.
+/// </summary>
 class SR_API Font
 {
 public:
     /// <summary>
     /// Create a default font.
-    /// Uses stb_easy_font to generate quad-based fonts.
+    /// The quads of stb_easy_font are rasterized once into a font image,
+    /// and text is drawn from the font image in the same way as TrueType fonts.
     /// </summary>
     /// <param name="size">The size of the font (in pixels) to generate.</param>
     explicit Font( float size = 1.5f );
 
     /// <summary>
     /// Load a font from a font file.
+    /// The glyphs are packed into a glyph atlas that is only used by this font.
+    /// Use ResourceManager::loadFont to share the glyph atlas between all sizes of the same font file.
     /// </summary>
     /// <param name="fontFile">The TrueType font to load.</param>
     /// <param name="size">(optional) The size of the font (in pixels) to generate. Default: 12</param>
     /// <param name="firstChar">(optional) The first character in the font texture. Default: ' '.</param>
     /// <param name="numChars">(optional) The number of characters in the font texture. Default: 96.</param>
-    Font( const std::filesystem::path& fontFile, float size = 12.0f, uint32_t firstChar = 32u, uint32_t numChars = 96u);
+    /// <param name="oversampling">(optional) The horizontal oversampling of the glyphs, used to position glyphs at sub-pixel precision. Default: 1.</param>
+    /// <param name="glyphMode">(optional) Store the glyphs as bitmaps or as distance fields (oversampling is ignored for distance fields). Default: GlyphMode::Bitmap.</param>
+    Font( const std::filesystem::path& fontFile, float size = 12.0f, uint32_t firstChar = 32u, uint32_t numChars = 96u, uint32_t oversampling = 1u, GlyphMode glyphMode = GlyphMode::Bitmap );
+
+    /// <summary>
+    /// Create a font from the glyphs of a glyph atlas. The range of characters is added to the atlas if needed.
+    /// If the atlas did not load its font file, the default font is used instead.
+    /// </summary>
+    /// <param name="glyphAtlas">The glyph atlas that contains the font file.</param>
+    /// <param name="size">(optional) The size of the font (in pixels) to generate. Default: 12</param>
+    /// <param name="firstChar">(optional) The first character in the font texture. Default: ' '.</param>
+    /// <param name="numChars">(optional) The number of characters in the font texture. Default: 96.</param>
+    /// <param name="oversampling">(optional) The horizontal oversampling of the glyphs, used to position glyphs at sub-pixel precision. Default: 1.</param>
+    /// <param name="glyphMode">(optional) Store the glyphs as bitmaps or as distance fields. Distance field glyphs are shared by all sizes of the font. Default: GlyphMode::Bitmap.</param>
+    Font( std::shared_ptr<GlyphAtlas> glyphAtlas, float size = 12.0f, uint32_t firstChar = 32u, uint32_t numChars = 96u, uint32_t oversampling = 1u, GlyphMode glyphMode = GlyphMode::Bitmap );
 
     /// <summary>
     /// Get the size of the area needed to render the given text using this font.
     /// </summary>
     /// <param name="text">The text to write.</param>
     /// <returns>The size of the rectangle needed to render this font.</returns>
-    glm::vec2 getSize( std::string_view text ) const noexcept;
+    glm::vec2 getSize( std::string_view text ) const;
+
+    /// <summary>
+    /// Get the area covered by the glyphs of the text, relative to the position the text is drawn at.
+    /// The bounds of recently measured text are cached, so measuring the same text every frame is cheap.
+    /// </summary>
+    /// <param name="text">The (UTF-8) text to measure.</param>
+    /// <returns>The bounds of the text.</returns>
+    Math::RectF getBounds( std::string_view text ) const;
+
+    /// <summary>
+    /// Get the distance between the pen positions before and after a line of text
+    /// (the sum of the advances of the glyphs, without measuring their bounds).
+    /// </summary>
+    /// <param name="text">The (UTF-8) text of a single line.</param>
+    /// <returns>The width of the line.</returns>
+    float getLineWidth( std::string_view text ) const noexcept;
+
+    /// <summary>
+    /// Get the position to draw the text at so that the glyphs of the text are centered on a point.
+    /// </summary>
+    /// <param name="text">The (UTF-8) text to center.</param>
+    /// <param name="center">The point to center the text on.</param>
+    /// <returns>The (whole pixel) position to pass to Image::drawText.</returns>
+    glm::vec2 getCenteredPosition( std::string_view text, const glm::vec2& center ) const;
+
+    /// <summary>
+    /// Break the text into lines that fit in a width.
+    /// Lines are broken at spaces (and at newlines). A word that doesn't fit on a line by itself is put on its own line.
+    /// The lines refer to the text, and the lines vector can be reused between calls to avoid allocating memory.
+    /// </summary>
+    /// <param name="text">The (UTF-8) text to wrap.</param>
+    /// <param name="width">The maximum width of a line (in pixels).</param>
+    /// <param name="lines">Receives the lines of the text (the vector is cleared first).</param>
+    void wrapText( std::string_view text, float width, std::vector<std::string_view>& lines ) const;
 
     float getFontSize() const noexcept
     {
         return size;
     }
 
+    /// <summary>
+    /// Get the distance between two lines of text.
+    /// </summary>
+    float getLineHeight() const noexcept
+    {
+        return lineHeight;
+    }
+
+    /// <summary>
+    /// Get the glyph atlas of the font (null for the default font).
+    /// </summary>
+    const std::shared_ptr<GlyphAtlas>& getGlyphAtlas() const noexcept
+    {
+        return glyphAtlas;
+    }
+
+    GlyphMode getGlyphMode() const noexcept
+    {
+        return glyphMode;
+    }
+
     // Font's can't be copied or moved (yet).
     Font( const Font& font ) = delete;
     Font( Font&& font )      = delete;
-    ~Font()                  = default;
+    ~Font();
 
     Font& operator=( const Font& font )     = delete;
     Font& operator=( Font&& font ) noexcept = delete;
@@ -61,15 +149,50 @@ private:
 
     void drawText( Image& image, std::wstring_view text, int x, int y, const Color& color ) const;
     void drawText( Image& image, std::string_view text, int x, int y, const Color& color ) const;
+    void drawTextShadow( Image& image, std::string_view text, int x, int y, const Color& color, const Color& shadowColor, const glm::ivec2& shadowOffset ) const;
+    void drawTextOutline( Image& image, std::string_view text, int x, int y, const Color& color, const Color& outlineColor ) const;
+
+    // Rasterize the glyphs of stb_easy_font into the font image (scaled by the font size).
+    void bakeEasyFont();
+
+    // The image that contains the glyphs of the font.
+    const std::shared_ptr<const AlphaImage>& getFontImage() const noexcept;
+    // Get the glyph of a character (or null if the font doesn't have a glyph for the character).
+    const stbtt_packedchar* getGlyph( uint32_t c ) const noexcept;
+
+    // Draw each glyph of the text directly from the font image (for text that is not cached).
+    void drawGlyphs( Image& image, std::string_view text, int x, int y, const Color& color ) const;
+
+    // Get the cached run of the (UTF-8) text. The text is rasterized if it is not in the cache.
+    TextRun& getTextRun( std::string_view text ) const;
+    // Rasterize the text into a coverage mask.
+    TextRun createTextRun( std::string_view text ) const;
+    // Measure the bounds of the text (without the cache).
+    Math::RectF measure( std::string_view text ) const noexcept;
+    // The position of a text run on the screen (the offset of the run is in the space of the font image).
+    glm::vec2 runPosition( const TextRun& run, int x, int y ) const noexcept;
 
     // The font size.
     float size;
     uint32_t firstChar = 0;
     uint32_t numChars = 0;
+    // The horizontal oversampling of the glyphs.
+    uint32_t oversampling = 1;
+    // Bitmap glyphs are drawn 1:1, distance field glyphs are scaled from the size they are stored at.
+    GlyphMode glyphMode  = GlyphMode::Bitmap;
+    float     glyphScale = 1.0f;
+    // The distance between two lines of text (in pixels).
+    float lineHeight = 0.0f;
+
+    // The glyphs of a TrueType font are stored in a range of a (shared) glyph atlas.
+    std::shared_ptr<GlyphAtlas> glyphAtlas;
+    size_t                      glyphRange = 0;
+
+    // The glyphs of the default font.
+    std::shared_ptr<const AlphaImage> fontImage;
+    std::vector<stbtt_packedchar>     fontChars;
 
-    stbtt_fontinfo                     fontInfo;
-    std::unique_ptr<Image>             fontImage;
-    std::unique_ptr<stbtt_bakedchar[]> bakedChar;
-    std::vector<unsigned char>         fontData;
+    // The text runs that were drawn with this font.
+    std::unique_ptr<TextCache> textCache;
 };
 }  // namespace Graphics
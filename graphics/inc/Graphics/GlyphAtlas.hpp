@@ -0,0 +1,183 @@
+#pragma once
+
+#include "AlphaImage.hpp"
+#include "Config.hpp"
+
+#include <stb_truetype.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Graphics
+{
+/// <summary>
+/// Packs the glyphs of a TrueType font into a single alpha image.
+/// All sizes (and character ranges) of the font share the same image, which is repacked
+/// and cropped to the area that is actually used whenever a new range is added.
+/// Distance field glyphs are rendered once (at DistanceFieldSize) into a separate image and can be drawn at any size.
+/// </summary>
+class SR_API GlyphAtlas final
+{
+public:
+    /// <summary>
+    /// The size of the font (in pixels) that distance field glyphs are rendered at.
+    /// </summary>
+    static constexpr float DistanceFieldSize = 32.0f;
+
+    /// <summary>
+    /// The number of pixels around each distance field glyph (the maximum distance to the edge of the glyph that is stored).
+    /// </summary>
+    static constexpr int DistanceFieldPadding = 6;
+
+    /// <summary>
+    /// The value of the distance field on the edge of a glyph (values are larger inside the glyph).
+    /// </summary>
+    static constexpr uint8_t DistanceFieldEdge = 128u;
+
+    /// <summary>
+    /// The change of the value of the distance field per pixel of distance to the edge of a glyph.
+    /// </summary>
+    static constexpr float DistanceFieldScale = 128.0f / static_cast<float>( DistanceFieldPadding );
+
+    /// <summary>
+    /// A range of characters of the font at a certain size.
+    /// </summary>
+    struct Range
+    {
+        /// <summary>
+        /// The size of the font (in pixels).
+        /// </summary>
+        float size;
+
+        /// <summary>
+        /// The first character of the range.
+        /// </summary>
+        uint32_t firstChar;
+
+        /// <summary>
+        /// The number of characters in the range.
+        /// </summary>
+        uint32_t numChars;
+
+        /// <summary>
+        /// The horizontal oversampling of the glyphs.
+        /// Oversampled glyphs are stored at a multiple of their width, so they can be positioned with sub-pixel precision
+        /// by only sampling every n-th pixel, starting at the pixel that matches the fractional position of the glyph.
+        /// </summary>
+        uint32_t oversampling;
+
+        /// <summary>
+        /// The rectangle of each glyph in the atlas image and its placement relative to the pen position.
+        /// </summary>
+        std::vector<stbtt_packedchar> chars;
+
+        /// <summary>
+        /// `true` if the glyphs are stored in the distance field image.
+        /// </summary>
+        bool distanceField = false;
+    };
+
+    /// <summary>
+    /// Load a font file. The atlas is empty until a range is added.
+    /// </summary>
+    /// <param name="fontFile">The TrueType font to load.</param>
+    explicit GlyphAtlas( const std::filesystem::path& fontFile );
+
+    // Glyph atlases are shared by fonts and can't be copied.
+    GlyphAtlas( const GlyphAtlas& )            = delete;
+    GlyphAtlas( GlyphAtlas&& )                 = delete;
+    GlyphAtlas& operator=( const GlyphAtlas& ) = delete;
+    GlyphAtlas& operator=( GlyphAtlas&& )      = delete;
+    ~GlyphAtlas()                              = default;
+
+    /// <summary>
+    /// Check if the font file was loaded.
+    /// </summary>
+    explicit operator bool() const noexcept
+    {
+        return !fontData.empty();
+    }
+
+    /// <summary>
+    /// Add a range of characters to the atlas. The atlas is repacked if the range is not already in the atlas.
+    /// </summary>
+    /// <param name="size">The size of the font (in pixels).</param>
+    /// <param name="firstChar">The first character of the range.</param>
+    /// <param name="numChars">The number of characters in the range.</param>
+    /// <param name="oversampling">(optional) The horizontal oversampling of the glyphs. Default: 1.</param>
+    /// <returns>The index of the range.</returns>
+    size_t addRange( float size, uint32_t firstChar, uint32_t numChars, uint32_t oversampling = 1u );
+
+    /// <summary>
+    /// Add a range of distance field glyphs to the atlas. The glyphs are rendered at DistanceFieldSize
+    /// and can be shared by fonts of any size.
+    /// </summary>
+    /// <param name="firstChar">The first character of the range.</param>
+    /// <param name="numChars">The number of characters in the range.</param>
+    /// <returns>The index of the range.</returns>
+    size_t addDistanceFieldRange( uint32_t firstChar, uint32_t numChars );
+
+    /// <summary>
+    /// Get a range of characters that was added to the atlas.
+    /// </summary>
+    /// <param name="index">The index of the range (returned by addRange).</param>
+    const Range& getRange( size_t index ) const noexcept
+    {
+        return ranges[index];
+    }
+
+    /// <summary>
+    /// Get the number of ranges in the atlas.
+    /// </summary>
+    size_t getNumRanges() const noexcept
+    {
+        return ranges.size();
+    }
+
+    /// <summary>
+    /// Get the image that contains the glyphs. The image is replaced when the atlas is repacked.
+    /// </summary>
+    const std::shared_ptr<const AlphaImage>& getImage() const noexcept
+    {
+        return image;
+    }
+
+    /// <summary>
+    /// Get the image that contains the distance field glyphs. The image is replaced when a distance field range is added.
+    /// </summary>
+    const std::shared_ptr<const AlphaImage>& getDistanceFieldImage() const noexcept
+    {
+        return distanceFieldImage;
+    }
+
+    /// <summary>
+    /// Get the number of glyphs in the atlas (of all ranges).
+    /// </summary>
+    size_t getNumGlyphs() const noexcept;
+
+    /// <summary>
+    /// Get the number of pixels of the atlas image that are covered by glyphs.
+    /// </summary>
+    size_t getGlyphArea() const noexcept;
+
+    /// <summary>
+    /// Get the fraction of the atlas images that is covered by glyphs (between 0 and 1).
+    /// </summary>
+    float getOccupancy() const noexcept;
+
+private:
+    // Pack the glyphs of all (bitmap) ranges into a new image.
+    void pack();
+    // Render the distance fields of a new range and pack them together with the existing distance field glyphs.
+    void packDistanceField( Range& range );
+
+    std::vector<unsigned char>        fontData;
+    stbtt_fontinfo                    fontInfo {};
+    std::vector<Range>                ranges;
+    std::shared_ptr<const AlphaImage> image;
+    std::shared_ptr<const AlphaImage> distanceFieldImage;
+};
+
+}  // namespace Graphics
@@ -4,6 +4,7 @@
 #include "Color.hpp"
 #include "Config.hpp"
 #include "Enums.hpp"
+#include "LineSegment.hpp"
 #include "Vertex.hpp"
 #include "aligned_unique_ptr.hpp"
 
@@ -14,18 +15,31 @@
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <span>
+#include <string_view>
 
 #include <glm/vec2.hpp>
 
 namespace Graphics
 {
 
+class AlphaImage;
 class Sprite;
+struct SDFStyle;
 class Font;
+class TextureAtlas;
+class TiledRenderer;
 
 class SR_API Image final
 {
 public:
+    /// <summary>
+    /// The file extension of cooked images.
+    /// Cooked images store the pixels in the memory layout of the image (and optionally premultiplied),
+    /// so they are loaded without decoding or converting the pixels.
+    /// </summary>
+    static constexpr std::string_view CookedExtension = ".tex";
+
     /// <summary>
     /// Default construct an image.
     /// The image is 0x0 with no buffer.
@@ -34,6 +48,7 @@ public:
 
     /// <summary>
     /// Load an image from a file.
+    /// Cooked images (see <see cref="Image::CookedExtension"/>) are memory mapped and copied to the image.
     /// </summary>
     /// <param name="fileName">The file to load.</param>
     explicit Image( const std::filesystem::path& fileName );
@@ -60,7 +75,7 @@ public:
     /// <summary>
     /// Destructor.
     /// </summary>
-    ~Image() = default;
+    ~Image();
 
     /// <summary>
     /// Copy assignment operator.
@@ -92,6 +107,36 @@ public:
     /// <param name="height">The new image height (in pixels).</param>
     void resize( uint32_t width, uint32_t height );
 
+    /// <summary>
+    /// Convert the image to premultiplied alpha (the color channels are multiplied by the alpha channel).
+    /// Premultiplied images should be drawn with <see cref="BlendMode::PremultipliedAlpha"/>, which
+    /// produces the same result as drawing the original image with <see cref="BlendMode::AlphaBlend"/>
+    /// but doesn't need to scale the source pixels.
+    /// Note: Does nothing if the image is already premultiplied.
+    /// </summary>
+    void premultiplyAlpha() noexcept;
+
+    /// <summary>
+    /// Check if the color channels of this image are premultiplied by the alpha channel.
+    /// </summary>
+    /// <returns>`true` if <see cref="Image::premultiplyAlpha"/> was called on this image, `false` otherwise.</returns>
+    bool isPremultiplied() const noexcept
+    {
+        return m_premultiplied;
+    }
+
+    /// <summary>
+    /// Get the generation of the pixels of this image.
+    /// The generation changes every time the pixels of the image can change (drawing to the image, clearing, resizing,
+    /// or getting non-const access to the pixels), and no two images share a generation.
+    /// Deferred draw calls compare the generation of the images they reference to find out if the images changed.
+    /// </summary>
+    /// <returns>The generation of the pixels of this image.</returns>
+    uint64_t getGeneration() const noexcept
+    {
+        return m_generation;
+    }
+
     /// <summary>
     /// Save the image to disk.
     /// Supported file formats are:
@@ -99,6 +144,8 @@ public:
     ///   * BMP
     ///   * TGA
     ///   * JPEG
+    ///   * Cooked images (<see cref="Image::CookedExtension"/>): the pixels are stored uncompressed
+    ///     in the layout of the image, including whether they are premultiplied.
     /// </summary>
     /// <param name="file">The name of the file to save this image to.</param>
     void save( const std::filesystem::path& file ) const;
@@ -109,6 +156,60 @@ public:
     /// <param name="color">The color to clear the screen to.</param>
     void clear( const Color& color ) noexcept;
 
+    /// <summary>
+    /// Start recording draw calls instead of rasterizing them immediately.
+    /// Recorded draw calls are binned into screen tiles and rasterized when
+    /// <see cref="Image::flush"/> or <see cref="Image::endDeferred"/> is called.
+    /// Note: Images that are referenced by recorded draw calls (for example, the source
+    /// image of a copy or a font texture) must stay alive until the commands are flushed.
+    /// </summary>
+    void beginDeferred();
+
+    /// <summary>
+    /// Rasterize all recorded draw calls and return to immediate mode.
+    /// </summary>
+    void endDeferred();
+
+    /// <summary>
+    /// Rasterize all recorded draw calls. Each screen tile is rasterized by a single
+    /// thread and the draw calls in each tile are rasterized in the order they were recorded.
+    /// Does nothing if the image is not in deferred mode.
+    /// </summary>
+    void flush();
+
+    /// <summary>
+    /// Check if draw calls are currently being recorded.
+    /// </summary>
+    /// <returns>`true` if the image is in deferred mode, `false` otherwise.</returns>
+    bool isDeferred() const noexcept
+    {
+        return m_deferred;
+    }
+
+    /// <summary>
+    /// Only redraw the parts of the image that changed since the previous flush.
+    /// The draw calls of each flush are compared against the draw calls of the previous flush,
+    /// and only the screen tiles that are overlapped by different draw calls are rasterized.
+    /// All other tiles keep the pixels of the previous frame.
+    /// Note: Draw calls are compared by value, and images that are referenced by draw calls are compared
+    /// by their generation (see <see cref="Image::getGeneration"/>), so changing a referenced image redraws
+    /// the tiles that it covers. Call <see cref="Image::invalidate"/> to redraw the whole image after
+    /// drawing to this image outside of deferred mode.
+    /// </summary>
+    /// <param name="enable">`true` to enable dirty tracking, `false` to redraw the whole image on every flush.</param>
+    void setDirtyTracking( bool enable );
+
+    /// <summary>
+    /// Check if dirty tracking is enabled.
+    /// </summary>
+    /// <returns>`true` if only the changed parts of the image are redrawn, `false` otherwise.</returns>
+    bool isDirtyTracking() const noexcept;
+
+    /// <summary>
+    /// Redraw the whole image on the next flush (only has an effect if dirty tracking is enabled).
+    /// </summary>
+    void invalidate() noexcept;
+
     /// <summary>
     /// Copy a region of the source image to a region of this image.
     /// If the source and destination regions are different, the image will be scaled.
@@ -193,6 +294,17 @@ public:
         drawLine( line.p0.x, line.p0.y, line.p1.x, line.p1.y, color, blendMode );
     }
 
+    /// <summary>
+    /// Draw a list of lines with the same color and blend mode.
+    /// This is faster than drawing each line separately: the raster state is only selected once,
+    /// lines that are completely outside of the image are rejected before they are clipped,
+    /// and the pixels of each line are written in horizontal or vertical runs.
+    /// </summary>
+    /// <param name="lines">The lines to draw.</param>
+    /// <param name="color">The color of the lines.</param>
+    /// <param name="blendMode">The blend mode to use.</param>
+    void drawLines( std::span<const LineSegment> lines, const Color& color, const BlendMode& blendMode = {} ) noexcept;
+
     /// <summary>
     /// Plot a 2D triangle.
     /// </summary>
@@ -242,6 +354,7 @@ public:
 
     /// <summary>
     /// Draw an axis-aligned bounding box to the image.
+    /// Each pixel of the box (or of its outline) is only drawn once, and the rows of a solid box are filled as horizontal spans.
     /// </summary>
     /// <param name="aabb">The AABB to draw.</param>
     /// <param name="color">The color of the AABB.</param>
@@ -251,6 +364,7 @@ public:
 
     /// <summary>
     /// Draw a circle.
+    /// The circle is drawn as an ellipse (see drawEllipse).
     /// </summary>
     /// <param name="circle">The circle to draw.</param>
     /// <param name="color">The color of the circle.</param>
@@ -283,6 +397,18 @@ public:
         drawCircle( Math::Circle { center, radius }, color, blendMode, fillMode );
     }
 
+    /// <summary>
+    /// Draw an axis-aligned ellipse.
+    /// The extent of each row of the ellipse is computed exactly, and the covered pixels are filled as horizontal spans.
+    /// In wireframe mode a one pixel wide ring is drawn.
+    /// </summary>
+    /// <param name="center">The center point of the ellipse.</param>
+    /// <param name="radii">The horizontal and vertical radius of the ellipse.</param>
+    /// <param name="color">The color of the ellipse.</param>
+    /// <param name="blendMode">(optional) The blend mode to use. Default: No blending.</param>
+    /// <param name="fillMode">(optional) The fill mode to use. Default: Solid.</param>
+    void drawEllipse( const glm::vec2& center, const glm::vec2& radii, const Color& color, const BlendMode& blendMode = {}, FillMode fillMode = FillMode::Solid ) noexcept;
+
     /// <summary>
     /// Draw a sprite on the screen using a 3x3 transformation matrix.
     /// </summary>
@@ -312,21 +438,79 @@ public:
         drawSprite(sprite, static_cast<int>( t.x ), static_cast<int>( t.y ) );
     }
 
+    /// <summary>
+    /// Draw a region of an alpha image in a single color.
+    /// The coverage of each mask pixel is multiplied with the alpha of the color and alpha blended with the image.
+    /// Pixels with zero coverage are skipped.
+    /// </summary>
+    /// <param name="mask">The alpha image to draw. In deferred mode the mask is kept alive until the image is flushed.</param>
+    /// <param name="srcRect">The region of the mask to draw.</param>
+    /// <param name="x">The x-coordinate of the top-left corner of the region on the screen.</param>
+    /// <param name="y">The y-coordinate of the top-left corner of the region on the screen.</param>
+    /// <param name="color">The color of the mask.</param>
+    /// <param name="step">(optional) The horizontal distance between the mask pixels that are drawn (used for oversampled glyphs).
+    /// The region covers (srcRect.width + step - 1) / step pixels of the image. Default: 1.</param>
+    void drawMask( const std::shared_ptr<const AlphaImage>& mask, const Math::RectI& srcRect, int x, int y, const Color& color, int step = 1 ) noexcept;
+
+    /// <summary>
+    /// Draw a region of a signed distance field at any scale.
+    /// The edge of the shape is found by thresholding the (bilinear filtered) distance field and smoothed over one pixel.
+    /// The fill, the outline, and the shadow of the style are composited in a single pass.
+    /// </summary>
+    /// <param name="sdf">The distance field to draw. In deferred mode the distance field is kept alive until the image is flushed.</param>
+    /// <param name="srcRect">The region of the distance field to draw.</param>
+    /// <param name="position">The position of the top-left corner of the region on the screen.</param>
+    /// <param name="scale">The size of a pixel of the distance field on the screen.</param>
+    /// <param name="style">The colors of the fill, the outline, and the shadow.</param>
+    void drawSDF( const std::shared_ptr<const AlphaImage>& sdf, const Math::RectI& srcRect, const glm::vec2& position, float scale, const SDFStyle& style ) noexcept;
+
     /// <summary>
     /// Draw text to the image.
+    /// The text is rasterized once and cached by the font, so drawing the same text again (in any color) is cheap.
     /// </summary>
     /// <param name="font">The font to use for font.</param>
     /// <param name="x">The x-coordinate of the top-left corner of the text.</param>
     /// <param name="y">The y-coordinate of the top-left corner fo the text.</param>
     /// <param name="text">The text to print to the screen.</param>
     /// <param name="color">The color of the text to draw on the screen.</param>
-    void drawText( const Font& font, std::string_view text, int x, int y, const Color& color ) noexcept;
-    void drawText( const Font& font, std::wstring_view text, int x, int y, const Color& color ) noexcept;
-    void drawText(const Font& font, std::string_view text, const glm::vec2& v, const Color& color) noexcept
+    void drawText( const Font& font, std::string_view text, int x, int y, const Color& color );
+    void drawText( const Font& font, std::wstring_view text, int x, int y, const Color& color );
+    void drawText(const Font& font, std::string_view text, const glm::vec2& v, const Color& color)
     {
         drawText(font, text, static_cast<int>( v.x ), static_cast<int>( v.y ), color);
     }
 
+    /// <summary>
+    /// Draw text with a drop shadow. The shadow is drawn first, using the same cached text as the text itself.
+    /// </summary>
+    /// <param name="font">The font to use for the text.</param>
+    /// <param name="text">The text to print to the screen.</param>
+    /// <param name="x">The x-coordinate of the top-left corner of the text.</param>
+    /// <param name="y">The y-coordinate of the top-left corner of the text.</param>
+    /// <param name="color">The color of the text.</param>
+    /// <param name="shadowColor">The color of the shadow.</param>
+    /// <param name="shadowOffset">The offset of the shadow relative to the text (in pixels).</param>
+    void drawTextShadow( const Font& font, std::string_view text, int x, int y, const Color& color, const Color& shadowColor, const glm::ivec2& shadowOffset );
+    void drawTextShadow( const Font& font, std::string_view text, const glm::vec2& v, const Color& color, const Color& shadowColor, const glm::ivec2& shadowOffset )
+    {
+        drawTextShadow( font, text, static_cast<int>( v.x ), static_cast<int>( v.y ), color, shadowColor, shadowOffset );
+    }
+
+    /// <summary>
+    /// Draw text with a one pixel outline. The outline is created from the cached text the first time it is needed.
+    /// </summary>
+    /// <param name="font">The font to use for the text.</param>
+    /// <param name="text">The text to print to the screen.</param>
+    /// <param name="x">The x-coordinate of the top-left corner of the text.</param>
+    /// <param name="y">The y-coordinate of the top-left corner of the text.</param>
+    /// <param name="color">The color of the text.</param>
+    /// <param name="outlineColor">The color of the outline.</param>
+    void drawTextOutline( const Font& font, std::string_view text, int x, int y, const Color& color, const Color& outlineColor );
+    void drawTextOutline( const Font& font, std::string_view text, const glm::vec2& v, const Color& color, const Color& outlineColor )
+    {
+        drawTextOutline( font, text, static_cast<int>( v.x ), static_cast<int>( v.y ), color, outlineColor );
+    }
+
     /// <summary>
     /// Plot a single pixel to the image. Out-of-bounds coordinates are discarded.
     /// </summary>
@@ -348,6 +532,8 @@ public:
             assert( y < m_height );
         }
 
+        m_generation = nextGeneration();
+
         const size_t i = static_cast<size_t>( y ) * m_width + x;
         if constexpr ( Blending )
         {
@@ -369,6 +555,16 @@ public:
     /// <returns>The color of the texel at the given UV coordinates.</returns>
     const Color& sample( int u, int v, AddressMode addressMode = AddressMode::Wrap ) const noexcept;
 
+    /// <summary>
+    /// Sample the image at integer coordinates with an address mode that is known at compile time.
+    /// </summary>
+    /// <typeparam name="A">Determines how to apply out-of-bounds texture coordinates.</typeparam>
+    /// <param name="u">The U texture coordinate.</param>
+    /// <param name="v">The V texture coordinate.</param>
+    /// <returns>The color of the texel at the given UV coordinates.</returns>
+    template<AddressMode A>
+    const Color& sample( int u, int v ) const noexcept;
+
     /// <summary>
     /// Sample the image at integer coordinates.
     /// </summary>
@@ -389,7 +585,7 @@ public:
     /// <returns>The color of the texel at the given UV texture coordinates.</returns>
     const Color& sample( float u, float v, AddressMode addressMode = AddressMode::Wrap ) const noexcept
     {
-        return sample( static_cast<int>( std::round( u * static_cast<float>( m_width ) ) ), static_cast<int>( std::round( v * static_cast<float>( m_height ) ) ), addressMode );
+        return sample( static_cast<int>( std::floor( u * static_cast<float>( m_width ) ) ), static_cast<int>( std::floor( v * static_cast<float>( m_height ) ) ), addressMode );
     }
 
     /// <summary>
@@ -416,6 +612,8 @@ public:
         assert( x < m_width );
         assert( y < m_height );
 
+        m_generation = nextGeneration();
+
         return m_data[static_cast<uint64_t>( y ) * m_width + x];
     }
 
@@ -440,10 +638,12 @@ public:
 
     /// <summary>
     /// Get a pointer to the pixel buffer.
+    /// Note: The generation of the image changes, since the pixels can be changed through the pointer.
     /// </summary>
     /// <returns>A pointer to the pixel buffer.</returns>
     Color* data() noexcept
     {
+        m_generation = nextGeneration();
         return m_data.get();
     }
 
@@ -457,11 +657,65 @@ public:
     }
 
 private:
+    friend class TiledRenderer;
+    friend class TextureAtlas;
+
+    // Get a new (globally unique) generation for an image whose pixels can change.
+    static uint64_t nextGeneration() noexcept;
+
+    // Load or save a cooked image.
+    void loadCooked( const std::filesystem::path& fileName );
+    void saveCooked( const std::filesystem::path& fileName ) const;
+
+    // Rasterizers shared by the immediate and the deferred (tiled) draw paths.
+    // Only pixels inside the `clip` AABB (which must be contained in this image's AABB) are written.
+    void rasterClear( const Color& color, const Math::AABB& clip ) noexcept;
+    void rasterCopy( const Image& srcImage, const Math::AABB& srcAABB, const Math::AABB& dstAABB, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterCopy( const Image& srcImage, int x, int y, const Math::AABB& clip ) noexcept;
+    void rasterLine( int x0, int y0, int x1, int y1, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterTriangle( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterQuad( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterQuad( const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vertex& v3, const Image& image, AddressMode addressMode, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterAABB( Math::AABB aabb, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterAABBOutline( const Math::AABB& aabb, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterEllipse( const glm::vec2& center, const glm::vec2& radii, float thickness, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+    void rasterSprite( const Sprite& sprite, const glm::mat3& matrix, const Color& color, const Math::AABB& clip ) noexcept;
+    void rasterSprite( const Sprite& sprite, int x, int y, const Math::AABB& clip ) noexcept;
+    void rasterMask( const AlphaImage& mask, const Math::RectI& srcRect, int x, int y, const Color& color, int step, const Math::AABB& clip ) noexcept;
+    void rasterSDF( const AlphaImage& sdf, const Math::RectI& srcRect, const glm::vec2& position, float scale, const SDFStyle& style, const Math::AABB& clip ) noexcept;
+
+    // The matrix that maps the trimmed rectangle of the sprite (instead of the whole sprite) to the image.
+    // Used to rasterize the sprite and to compute its bounds in deferred mode.
+    static glm::mat3 trimmedSpriteMatrix( const Sprite& sprite, const glm::mat3& matrix ) noexcept;
+
+    // Copy the trimmed rectangle of the sprite row by row (reading the rows backwards if the sprite is mirrored horizontally).
+    // (x, y) is the position of the top-left corner of the trimmed rectangle.
+    void blitSprite( const Sprite& sprite, int x, int y, bool mirrorX, bool mirrorY, const Color& color, const Math::AABB& clip ) noexcept;
+
+    // Rasterize a line that is already clipped to the image as horizontal (or vertical) runs of pixels.
+    template<typename State>
+    void rasterLineRuns( int x0, int y0, int x1, int y1, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+
+    // Draw the transformed source rectangle of an image by inverse mapping each covered scanline span.
+    template<typename State>
+    void blitAffine( const Image& image, const Math::RectI& srcRect, const glm::mat3& matrix, const Color& color, const BlendMode& blendMode, const Math::AABB& clip ) noexcept;
+
     uint32_t m_width  = 0u;
     uint32_t m_height = 0u;
     // Axis-aligned bounding box used for screen clipping.
     Math::AABB                  m_AABB;
     aligned_unique_ptr<Color[]> m_data;
+    // Set to true if the color channels are premultiplied by alpha.
+    bool m_premultiplied = false;
+    // Changes whenever the pixels can change (see getGeneration).
+    uint64_t m_generation = nextGeneration();
+
+    // Set to true while draw calls are being recorded (and while they are flushed).
+    // The rasterizers don't spawn their own parallel regions in deferred mode
+    // since each tile is already processed by its own thread.
+    bool m_deferred = false;
+    // Records and bins draw calls in deferred mode.
+    std::unique_ptr<TiledRenderer> m_tiledRenderer;
 };
 
 template<typename T>
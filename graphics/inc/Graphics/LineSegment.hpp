@@ -0,0 +1,22 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+namespace Graphics
+{
+/// <summary>
+/// A line between two pixels, used to draw batches of lines with Image::drawLines.
+/// </summary>
+struct LineSegment
+{
+    constexpr LineSegment( const glm::ivec2& p0 = glm::ivec2 { 0 }, const glm::ivec2& p1 = glm::ivec2 { 0 } )
+    : p0 { p0 }
+    , p1 { p1 }
+    {}
+
+    glm::ivec2 p0 { 0 };
+    glm::ivec2 p1 { 0 };
+
+    bool operator==( const LineSegment& ) const = default;
+};
+}  // namespace Graphics
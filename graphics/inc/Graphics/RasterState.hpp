@@ -0,0 +1,178 @@
+#pragma once
+
+#include "BlendMode.hpp"
+#include "Color.hpp"
+#include "Enums.hpp"
+#include "Image.hpp"
+
+#include <cstddef>
+
+namespace Graphics
+{
+/// <summary>
+/// The state of a draw call that doesn't change for the duration of the draw, encoded in the type.
+/// Raster loops that are instantiated for a RasterState don't branch on the blend mode, color modulation,
+/// or address mode. Use dispatchRasterState to select the instantiation that matches the state of a draw call.
+/// </summary>
+/// <typeparam name="Blend">The preset of the blend mode.</typeparam>
+/// <typeparam name="Modulate">Multiply the source pixels by a color.</typeparam>
+/// <typeparam name="Address">The address mode used for texture sampling.</typeparam>
+template<BlendPreset Blend, bool Modulate = false, AddressMode Address = AddressMode::Clamp>
+struct RasterState
+{
+    static constexpr BlendPreset blendPreset = Blend;
+    static constexpr bool        modulate    = Modulate;
+    static constexpr AddressMode addressMode = Address;
+
+    /// <summary>
+    /// Modulate a source pixel with a color.
+    /// </summary>
+    /// <param name="src">The source pixel.</param>
+    /// <param name="color">The color to multiply the source pixel with.</param>
+    /// <returns>The modulated source pixel (or the source pixel if color modulation is disabled).</returns>
+    static constexpr Color shade( const Color& src, [[maybe_unused]] const Color& color ) noexcept
+    {
+        if constexpr ( Modulate && Blend == BlendPreset::PremultipliedAlpha )
+            return src * ( color * Color { color.a, color.a, color.a } );  // Premultiply the (straight alpha) color.
+        else if constexpr ( Modulate )
+            return src * color;
+        else
+            return src;
+    }
+
+    /// <summary>
+    /// Sample an image at integer coordinates.
+    /// </summary>
+    /// <param name="image">The image to sample.</param>
+    /// <param name="u">The U texture coordinate.</param>
+    /// <param name="v">The V texture coordinate.</param>
+    /// <returns>The color of the texel.</returns>
+    static const Color& sample( const Image& image, int u, int v ) noexcept
+    {
+        return image.sample<Address>( u, v );
+    }
+
+    /// <summary>
+    /// Blend a span of source pixels into a span of destination pixels.
+    /// </summary>
+    static void blend( Color* dst, const Color* src, size_t count, const BlendMode& blendMode ) noexcept
+    {
+        blendSpan<Blend>( dst, src, count, blendMode );
+    }
+
+    /// <summary>
+    /// Blend a single color into a span of destination pixels.
+    /// </summary>
+    static void blend( Color* dst, const Color& src, size_t count, const BlendMode& blendMode ) noexcept
+    {
+        blendSpan<Blend>( dst, src, count, blendMode );
+    }
+
+    /// <summary>
+    /// Blend a single pixel into a destination pixel.
+    /// </summary>
+    /// <param name="dst">The destination pixel.</param>
+    /// <param name="src">The source color.</param>
+    /// <param name="blendMode">The blend mode (only used for BlendPreset::Custom).</param>
+    static void plot( Color& dst, const Color& src, const BlendMode& blendMode ) noexcept
+    {
+        dst = blendPixel<Blend>( src, dst, blendMode );
+    }
+};
+
+namespace detail
+{
+template<BlendPreset Blend, bool Modulate, typename Func>
+void dispatchAddressMode( AddressMode addressMode, Func&& func )
+{
+    switch ( addressMode )
+    {
+    case AddressMode::Wrap:
+        func( RasterState<Blend, Modulate, AddressMode::Wrap> {} );
+        break;
+    case AddressMode::Mirror:
+        func( RasterState<Blend, Modulate, AddressMode::Mirror> {} );
+        break;
+    case AddressMode::Clamp:
+        func( RasterState<Blend, Modulate, AddressMode::Clamp> {} );
+        break;
+    }
+}
+
+template<BlendPreset Blend, typename Func>
+void dispatchModulate( bool modulate, AddressMode addressMode, Func&& func )
+{
+    if ( modulate )
+        dispatchAddressMode<Blend, true>( addressMode, func );
+    else
+        dispatchAddressMode<Blend, false>( addressMode, func );
+}
+}  // namespace detail
+
+/// <summary>
+/// Invoke a function with the RasterState that matches the state of a draw call.
+/// The function is invoked with a (default constructed) RasterState object: use <c>decltype( state )</c> to access the state type.
+/// </summary>
+/// <param name="blendMode">The blend mode of the draw call.</param>
+/// <param name="modulate">Whether the source pixels are multiplied by a color.</param>
+/// <param name="addressMode">The address mode used for texture sampling.</param>
+/// <param name="func">The function to invoke.</param>
+template<typename Func>
+void dispatchRasterState( const BlendMode& blendMode, bool modulate, AddressMode addressMode, Func&& func )
+{
+    switch ( blendMode.getPreset() )
+    {
+    case BlendPreset::Disable:
+        detail::dispatchModulate<BlendPreset::Disable>( modulate, addressMode, func );
+        break;
+    case BlendPreset::AlphaBlend:
+        detail::dispatchModulate<BlendPreset::AlphaBlend>( modulate, addressMode, func );
+        break;
+    case BlendPreset::AdditiveBlend:
+        detail::dispatchModulate<BlendPreset::AdditiveBlend>( modulate, addressMode, func );
+        break;
+    case BlendPreset::SubtractiveBlend:
+        detail::dispatchModulate<BlendPreset::SubtractiveBlend>( modulate, addressMode, func );
+        break;
+    case BlendPreset::PremultipliedAlpha:
+        detail::dispatchModulate<BlendPreset::PremultipliedAlpha>( modulate, addressMode, func );
+        break;
+    case BlendPreset::Custom:
+        detail::dispatchModulate<BlendPreset::Custom>( modulate, addressMode, func );
+        break;
+    }
+}
+
+/// <summary>
+/// Invoke a function with the RasterState that matches the blend mode of a draw call
+/// that doesn't sample a texture or modulate the source pixels.
+/// </summary>
+/// <param name="blendMode">The blend mode of the draw call.</param>
+/// <param name="func">The function to invoke.</param>
+template<typename Func>
+void dispatchRasterState( const BlendMode& blendMode, Func&& func )
+{
+    switch ( blendMode.getPreset() )
+    {
+    case BlendPreset::Disable:
+        func( RasterState<BlendPreset::Disable> {} );
+        break;
+    case BlendPreset::AlphaBlend:
+        func( RasterState<BlendPreset::AlphaBlend> {} );
+        break;
+    case BlendPreset::AdditiveBlend:
+        func( RasterState<BlendPreset::AdditiveBlend> {} );
+        break;
+    case BlendPreset::SubtractiveBlend:
+        func( RasterState<BlendPreset::SubtractiveBlend> {} );
+        break;
+    case BlendPreset::PremultipliedAlpha:
+        func( RasterState<BlendPreset::PremultipliedAlpha> {} );
+        break;
+    case BlendPreset::Custom:
+        func( RasterState<BlendPreset::Custom> {} );
+        break;
+    }
+}
+
+}  // namespace Graphics
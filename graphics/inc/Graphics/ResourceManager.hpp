@@ -2,45 +2,104 @@
 
 #include "Config.hpp"
 #include "Font.hpp"
+#include "GlyphAtlas.hpp"
 #include "Image.hpp"
 #include "SpriteSheet.hpp"
+#include "TextureAtlas.hpp"
 
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <span>
 
 namespace Graphics
 {
+/// <summary>
+/// Loads and caches resources, so that resources that are loaded multiple times are only loaded once.
+/// The resource manager is thread-safe: resources can be loaded from multiple threads at the same time.
+/// </summary>
 class SR_API ResourceManager final
 {
 public:
     /// <summary>
     /// Load an image from a file.
+    /// If the image is being loaded by another thread, this waits until it is loaded.
+    /// If a cooked version of the image (see <see cref="ResourceManager::cookImages"/>) is at least as new as the image, the cooked image is loaded instead.
     /// </summary>
     /// <param name="filePath">The path to the file to load.</param>
+    /// <param name="premultiplyAlpha">(optional) Convert the image to premultiplied alpha after loading. Default: false.</param>
     /// <returns>The loaded image.</returns>
-    static std::shared_ptr<Image> loadImage( const std::filesystem::path& filePath );
+    static std::shared_ptr<Image> loadImage( const std::filesystem::path& filePath, bool premultiplyAlpha = false );
+
+    /// <summary>
+    /// Start loading an image on a worker thread.
+    /// The image is added to the cache, so that <see cref="ResourceManager::loadImage"/> returns the same image.
+    /// </summary>
+    /// <param name="filePath">The path to the file to load.</param>
+    /// <param name="premultiplyAlpha">(optional) Convert the image to premultiplied alpha after loading. Default: false.</param>
+    /// <returns>A future that holds the loaded image (ready immediately if the image is already cached).</returns>
+    static std::shared_future<std::shared_ptr<Image>> loadImageAsync( const std::filesystem::path& filePath, bool premultiplyAlpha = false );
+
+    /// <summary>
+    /// Load images on all cores and add them to the cache. Returns when all images are loaded.
+    /// Preloading the images that are used by sprite sheets (with the same premultiplied alpha setting) avoids decoding them one at a time when the sprite sheets are loaded.
+    /// </summary>
+    /// <param name="filePaths">The paths to the files to load.</param>
+    /// <param name="premultiplyAlpha">(optional) Convert the images to premultiplied alpha after loading. Default: false.</param>
+    static void preload( std::span<const std::filesystem::path> filePaths, bool premultiplyAlpha = false );
+
+    /// <summary>
+    /// Convert images to cooked images (see <see cref="Image::CookedExtension"/>) next to the source images.
+    /// Cooked images are loaded by <see cref="ResourceManager::loadImage"/> without decoding or converting the pixels.
+    /// Images that are cooked with premultiplied alpha are only used when the image is loaded with premultiplied alpha.
+    /// </summary>
+    /// <param name="filePaths">The paths to the images to cook.</param>
+    /// <param name="premultiplyAlpha">(optional) Store the images with premultiplied alpha. Default: false.</param>
+    static void cookImages( std::span<const std::filesystem::path> filePaths, bool premultiplyAlpha = false );
 
     /// <summary>
     /// Load a sprite sheet from a file.
+    /// Sprite sheets that are loaded with the same parameters are shared.
     /// </summary>
     /// <param name="filePath">The file path to the image.</param>
     /// <param name="spriteWidth">(optional) The width (in pixels) of a sprite in the sprite sheet. Default: image width.</param>
     /// <param name="spriteHeight">(optional) The height (in pixels) of a sprite in the sprite sheet. Default: image height.</param>
     /// <param name="padding">(optional) The amount of space (in pixels) between each sprite in the sprite sheet. Default: 0.</param>
     /// <param name="margin">(optional) The amount of space (in pixels) around the entire image. Default: 0.</param>
-    /// <param name="blendMode">(optional) The blend mode to use when rendering the sprites in this sprite sheet. Default: No blending.</param>
+    /// <param name="blendMode">(optional) The blend mode to use when rendering the sprites in this sprite sheet. Default: No blending.
+    /// If the blend mode is BlendMode::PremultipliedAlpha, the image is converted to premultiplied alpha when it is loaded.</param>
     /// <returns>The loaded SpriteSheet.</returns>
     static std::shared_ptr<SpriteSheet> loadSpriteSheet( const std::filesystem::path& filePath, std::optional<uint32_t> spriteWidth = {}, std::optional<uint32_t> spriteHeight = {}, uint32_t padding = 0u, uint32_t margin = 0u, const BlendMode& blendMode = {} );
 
     /// <summary>
     /// Load a font from a file.
+    /// All sizes and character ranges of the same font file share a single glyph atlas.
     /// </summary>
     /// <param name="fontFile">The path to the font to load.</param>
     /// <param name="size">(optional) The size of the font (in pixels). Default: 12</param>
     /// <param name="firstChar">(optional) The first character in the font texture. Default: ' '.</param>
     /// <param name="numChars">(optional) The number of characters in the font texture. Default: 96.</param>
+    /// <param name="oversampling">(optional) The horizontal oversampling of the glyphs. Default: 1.</param>
+    /// <param name="glyphMode">(optional) Store the glyphs as bitmaps or as distance fields. Default: GlyphMode::Bitmap.</param>
     /// <returns>A shared pointer to the loaded font.</returns>
-    static std::shared_ptr<Font> loadFont( const std::filesystem::path& fontFile, float size = 12.0f, uint32_t firstChar = 32u, uint32_t numChars = 96u );
+    static std::shared_ptr<Font> loadFont( const std::filesystem::path& fontFile, float size = 12.0f, uint32_t firstChar = 32u, uint32_t numChars = 96u, uint32_t oversampling = 1u, GlyphMode glyphMode = GlyphMode::Bitmap );
+
+    /// <summary>
+    /// Load the glyph atlas of a font file. The glyph atlas is shared by all fonts that are loaded from the same file.
+    /// </summary>
+    /// <param name="fontFile">The path to the font file.</param>
+    /// <returns>The glyph atlas of the font file.</returns>
+    static std::shared_ptr<GlyphAtlas> loadGlyphAtlas( const std::filesystem::path& fontFile );
+
+    /// <summary>
+    /// Pack the sprites of all loaded sprite sheets into a texture atlas.
+    /// Identical frames are only stored once, and images that were used before packing
+    /// but are only referenced by the resource manager after packing are unloaded.
+    /// Sprite sheets that are loaded after packing are not part of the atlas.
+    /// </summary>
+    /// <param name="pageSize">(optional) The width and maximum height of an atlas page (in pixels). Default: 1024.</param>
+    /// <returns>The texture atlas that contains the sprites.</returns>
+    static std::shared_ptr<TextureAtlas> packSpriteSheets( uint32_t pageSize = TextureAtlas::DefaultPageSize );
 
     /// <summary>
     /// Unload all resources.
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Color.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+
+namespace Graphics
+{
+/// <summary>
+/// The appearance of a signed distance field that is drawn with Image::drawSDF.
+/// The fill, the outline, and the shadow are all computed from the same distance field in a single pass.
+/// </summary>
+struct SDFStyle
+{
+    /// <summary>
+    /// The color inside the shape.
+    /// </summary>
+    Color color = Color::White;
+
+    /// <summary>
+    /// The color of the outline around the shape.
+    /// </summary>
+    Color outlineColor = Color::Black;
+
+    /// <summary>
+    /// The width of the outline (in pixels on the screen). No outline is drawn if the width is 0.
+    /// </summary>
+    float outlineWidth = 0.0f;
+
+    /// <summary>
+    /// The color of the shadow. No shadow is drawn if the shadow color is fully transparent.
+    /// </summary>
+    Color shadowColor = Color { 0, 0, 0, 0 };
+
+    /// <summary>
+    /// The offset of the shadow relative to the shape (in pixels on the screen).
+    /// </summary>
+    glm::vec2 shadowOffset { 0.0f };
+
+    /// <summary>
+    /// The width of the soft edge of the shadow (in pixels on the screen).
+    /// </summary>
+    float shadowSoftness = 0.0f;
+
+    /// <summary>
+    /// The value of the distance field on the edge of the shape (values are larger inside the shape).
+    /// </summary>
+    uint8_t edge = 128u;
+
+    /// <summary>
+    /// The change of the value of the distance field per pixel of the distance field.
+    /// </summary>
+    float distanceScale = 32.0f;
+
+    bool operator==( const SDFStyle& ) const = default;
+};
+}  // namespace Graphics
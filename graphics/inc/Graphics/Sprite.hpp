@@ -3,11 +3,15 @@
 #include "BlendMode.hpp"
 #include "Config.hpp"
 #include "Image.hpp"
+#include "SpriteSpans.hpp"
 
 #include <Math/Rect.hpp>
 
 #include <glm/vec2.hpp>
 
+#include <memory>
+#include <optional>
+
 namespace Graphics
 {
 class SR_API Sprite final
@@ -23,6 +27,7 @@ public:
     explicit Sprite( std::shared_ptr<Image> _image, const BlendMode& blendMode = {} ) noexcept
     : image { std::move( _image ) }
     , rect { 0, 0, static_cast<int32_t>( image->getWidth() ), static_cast<int32_t>( image->getHeight() ) }
+    , trimRect { rect }
     , blendMode { blendMode }
     {}
 
@@ -32,10 +37,14 @@ public:
     /// <param name="_image">The image that contains the sprite sheet.</param>
     /// <param name="rect">The source rectangle of this sprite in the image.</param>
     /// <param name="blendMode">The blend mode to apply when rendering.</param>
-    Sprite( std::shared_ptr<Image> _image, const Math::RectI& rect, const BlendMode& blendMode = {} ) noexcept
+    /// <param name="_spans">(optional) The run-length encoded alpha channel of the (trimmed) sprite. Transparent pixels are skipped when the sprite is drawn with alpha blending.</param>
+    /// <param name="_trimRect">(optional) The rectangle of the visible pixels in the image. Only this part of the sprite is drawn. Default: the source rectangle.</param>
+    Sprite( std::shared_ptr<Image> _image, const Math::RectI& rect, const BlendMode& blendMode = {}, std::shared_ptr<const SpriteSpans> _spans = {}, std::optional<Math::RectI> _trimRect = {} ) noexcept
     : image { std::move( _image ) }
     , rect { rect }
+    , trimRect { _trimRect.value_or( rect ) }
     , blendMode { blendMode }
+    , spans { std::move( _spans ) }
     {}
 
     glm::ivec2 getUV() const noexcept
@@ -63,11 +72,57 @@ public:
         return rect;
     }
 
+    /// <summary>
+    /// Get the rectangle of the visible pixels of the sprite in the image.
+    /// Only this part of the sprite is drawn, but the sprite is still positioned
+    /// (and anchored) using the full source rectangle.
+    /// </summary>
+    const Math::RectI& getTrimRect() const noexcept
+    {
+        return trimRect;
+    }
+
+    /// <summary>
+    /// Get the offset of the visible pixels relative to the top-left corner of the sprite.
+    /// </summary>
+    glm::ivec2 getTrimOffset() const noexcept
+    {
+        return { trimRect.left - rect.left, trimRect.top - rect.top };
+    }
+
     std::shared_ptr<Image> getImage() const noexcept
     {
         return image;
     }
 
+    /// <summary>
+    /// Move the sprite to a different image that contains the same (visible) pixels, for example a texture atlas.
+    /// The source rectangle is moved together with the trimmed rectangle so the sprite keeps its size and anchor.
+    /// Only the pixels inside the trimmed rectangle are expected to be in the new image.
+    /// </summary>
+    /// <param name="_image">The image that contains the pixels of the sprite.</param>
+    /// <param name="trimUV">The top-left corner of the visible pixels of the sprite in the new image.</param>
+    void setImage( std::shared_ptr<Image> _image, const glm::ivec2& trimUV ) noexcept
+    {
+        const glm::ivec2 offset = getTrimOffset();
+
+        image         = std::move( _image );
+        rect.left     = trimUV.x - offset.x;
+        rect.top      = trimUV.y - offset.y;
+        trimRect.left = trimUV.x;
+        trimRect.top  = trimUV.y;
+        trimOnly      = trimRect != rect;
+    }
+
+    /// <summary>
+    /// Get the run-length encoded alpha channel of the sprite.
+    /// </summary>
+    /// <returns>The spans of the sprite, or `nullptr` if the sprite was not encoded.</returns>
+    const SpriteSpans* getSpans() const noexcept
+    {
+        return spans.get();
+    }
+
     const Color& getColor() const noexcept
     {
         return color;
@@ -83,9 +138,37 @@ public:
         return blendMode;
     }
 
-    void setBlendMode( const BlendMode& _blendMode )
+    /// <summary>
+    /// Set the blend mode of the sprite.
+    /// If the sprite is trimmed to its visible pixels and the new blend mode can't skip the transparent pixels
+    /// (see <see cref="Sprite::canTrim"/>), the whole source rectangle is drawn again.
+    /// Sprites that were moved to a texture atlas keep their trimmed rectangle, because the atlas only stores their visible pixels.
+    /// </summary>
+    /// <param name="_blendMode">The blend mode to apply when rendering.</param>
+    void setBlendMode( const BlendMode& _blendMode ) noexcept
     {
         blendMode = _blendMode;
+
+        if ( image && trimRect != rect && !trimOnly && !canTrim( blendMode, *image ) )
+        {
+            // The spans were encoded for the trimmed rectangle.
+            trimRect = rect;
+            spans.reset();
+        }
+    }
+
+    /// <summary>
+    /// Check if sprites can be trimmed to their visible pixels.
+    /// Fully transparent pixels only leave the destination unchanged if they are alpha blended
+    /// (or blended with premultiplied alpha and the image is premultiplied).
+    /// </summary>
+    /// <param name="blendMode">The blend mode the sprites are drawn with.</param>
+    /// <param name="image">The image that contains the sprites.</param>
+    /// <returns>`true` if the transparent pixels around the sprites can be skipped, `false` otherwise.</returns>
+    static bool canTrim( const BlendMode& blendMode, const Image& image ) noexcept
+    {
+        const BlendPreset preset = blendMode.getPreset();
+        return preset == BlendPreset::AlphaBlend || ( preset == BlendPreset::PremultipliedAlpha && image.isPremultiplied() );
     }
 
     /// <summary>
@@ -97,6 +180,11 @@ public:
         return image != nullptr;
     }
 
+    /// <summary>
+    /// Check if two sprites refer to the same region of the same image and are drawn with the same color and blend mode.
+    /// </summary>
+    bool operator==( const Sprite& ) const noexcept = default;
+
 private:
     // The image that stores the pixels for this sprite.
     std::shared_ptr<Image> image;
@@ -104,10 +192,19 @@ private:
     // The source rectangle of this sprite in the image.
     Math::RectI rect;
 
+    // The rectangle of the visible pixels of the sprite (contained in the source rectangle).
+    Math::RectI trimRect;
+
     // The color to apply to the sprite.
     Color color { Color::White };
 
     // The blend mode to apply when rendering.
     BlendMode blendMode;
+
+    // The runs of visible pixels in each row of the sprite (shared by all copies of the sprite sheet).
+    std::shared_ptr<const SpriteSpans> spans;
+
+    // The image only contains the pixels inside the trimmed rectangle (the sprite was moved to a texture atlas).
+    bool trimOnly = false;
 };
 }  // namespace Graphics
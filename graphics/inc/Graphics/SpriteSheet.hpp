@@ -4,11 +4,13 @@
 #include "Config.hpp"
 #include "Image.hpp"
 #include "Sprite.hpp"
+#include "SpriteSpans.hpp"
 
 #include <Math/Rect.hpp>
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <span>
 
@@ -168,6 +170,9 @@ public:
     static std::shared_ptr<SpriteSheet> fromGrid( const std::filesystem::path& fileName, uint32_t columns, uint32_t rows = 1, uint32_t padding = 0u, uint32_t margin = 0u, const BlendMode& blendMode = {} );
 
 private:
+    // The atlas replaces the sprites with sprites that refer to the atlas pages.
+    friend class TextureAtlas;
+
     // Create a sprite sheet from a pre-loaded sprite image.
     void initSpriteRects();
     void initSprites();
@@ -181,6 +186,19 @@ private:
     // Sprite rectangles in the image.
     std::vector<Math::RectI> spriteRects;
 
+    // The visible part of a sprite.
+    struct VisibleRegion
+    {
+        // The rectangle of the visible pixels in the image.
+        Math::RectI rect;
+        // The run-length encoded alpha channel of the visible pixels.
+        SpriteSpans spans;
+    };
+
+    // The visible region of each sprite.
+    // The regions are only computed once and shared with copies of the sprite sheet.
+    std::shared_ptr<const std::vector<VisibleRegion>> visibleRegions;
+
     // The number of sprites in the X-axis of the image.
     uint32_t columns = 0u;
     // The number of sprites in the Y-axis of the image.
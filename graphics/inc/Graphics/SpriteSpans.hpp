@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Config.hpp"
+
+#include <Math/Rect.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Graphics
+{
+class Image;
+
+/// <summary>
+/// A run-length encoding of the alpha channel of a sprite.
+/// Each row of the sprite is split into runs of fully transparent pixels (skip runs),
+/// fully opaque pixels (copy runs), and partially transparent pixels (blend runs).
+/// Only the copy and blend runs are stored: the pixels between the runs are skipped.
+/// </summary>
+class SR_API SpriteSpans final
+{
+public:
+    /// <summary>
+    /// A run of visible pixels in a row of the sprite.
+    /// </summary>
+    struct Run
+    {
+        /// <summary>
+        /// The x-coordinate of the first pixel of the run (relative to the left edge of the sprite).
+        /// </summary>
+        uint32_t x;
+
+        /// <summary>
+        /// The number of pixels in the run.
+        /// </summary>
+        uint32_t length;
+
+        /// <summary>
+        /// `true` if all pixels in the run are fully opaque, `false` if they need to be blended.
+        /// </summary>
+        bool opaque;
+    };
+
+    SpriteSpans() = default;
+
+    /// <summary>
+    /// Encode the alpha channel of a region of an image.
+    /// </summary>
+    /// <param name="image">The image that contains the sprite.</param>
+    /// <param name="rect">The source rectangle of the sprite in the image.</param>
+    SpriteSpans( const Image& image, const Math::RectI& rect );
+
+    /// <summary>
+    /// Get the runs of visible pixels in a row of the sprite.
+    /// </summary>
+    /// <param name="y">The row of the sprite (relative to the top edge of the sprite).</param>
+    /// <returns>The runs in the row, ordered from left to right.</returns>
+    std::span<const Run> getRow( int y ) const noexcept
+    {
+        return { runs.data() + rows[y], runs.data() + rows[y + 1] };
+    }
+
+    /// <summary>
+    /// Get the number of rows in the sprite.
+    /// </summary>
+    int getHeight() const noexcept
+    {
+        return static_cast<int>( rows.size() ) - 1;
+    }
+
+    /// <summary>
+    /// Get the total number of (copy and blend) runs in the sprite.
+    /// </summary>
+    size_t getNumRuns() const noexcept
+    {
+        return runs.size();
+    }
+
+private:
+    // The runs of all rows.
+    std::vector<Run> runs;
+    // The index of the first run of each row (plus one past the last run of the last row).
+    std::vector<uint32_t> rows { 0u };
+};
+
+}  // namespace Graphics
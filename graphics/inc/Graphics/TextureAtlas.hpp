@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Image.hpp"
+#include "Sprite.hpp"
+#include "SpriteSheet.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Graphics
+{
+/// <summary>
+/// Packs the frames of sprites into a few large images (pages).
+/// Only the visible (trimmed) pixels of each frame are stored, and frames with identical pixels are only stored once.
+/// Drawing many sprites from the same pages improves memory locality and reduces the number of image allocations.
+/// </summary>
+class SR_API TextureAtlas final
+{
+public:
+    /// <summary>
+    /// The default width and (maximum) height of a page (in pixels).
+    /// </summary>
+    static constexpr uint32_t DefaultPageSize = 1024u;
+
+    /// <summary>
+    /// The horizontal position of each frame in a page is aligned to this number of pixels (16 bytes),
+    /// so that the rows of the frames start on a SIMD boundary.
+    /// </summary>
+    static constexpr uint32_t Alignment = 4u;
+
+    /// <summary>
+    /// Create an empty texture atlas.
+    /// </summary>
+    /// <param name="pageSize">(optional) The width and maximum height of a page (in pixels). Frames that are larger than a page get their own page.</param>
+    explicit TextureAtlas( uint32_t pageSize = DefaultPageSize );
+
+    /// <summary>
+    /// Pack the frames of the sprites into new pages of the atlas.
+    /// </summary>
+    /// <param name="sprites">The sprites to pack.</param>
+    /// <returns>Copies of the sprites that refer to the atlas pages (in the same order as the input sprites).</returns>
+    std::vector<Sprite> pack( std::span<const Sprite> sprites );
+
+    /// <summary>
+    /// Pack the sprites of the sprite sheets into new pages of the atlas.
+    /// The sprites of the sprite sheets are replaced by sprites that refer to the atlas pages
+    /// and the sprite sheets release their original images.
+    /// </summary>
+    /// <param name="spriteSheets">The sprite sheets to pack.</param>
+    void pack( std::span<const std::shared_ptr<SpriteSheet>> spriteSheets );
+
+    /// <summary>
+    /// Get the pages of the atlas.
+    /// </summary>
+    const std::vector<std::shared_ptr<Image>>& getPages() const noexcept
+    {
+        return pages;
+    }
+
+    /// <summary>
+    /// Get the number of frames that were packed into the atlas.
+    /// </summary>
+    size_t getNumFrames() const noexcept
+    {
+        return numFrames;
+    }
+
+    /// <summary>
+    /// Get the number of unique frames that are stored in the atlas (after removing duplicate frames).
+    /// </summary>
+    size_t getNumUniqueFrames() const noexcept
+    {
+        return numUniqueFrames;
+    }
+
+private:
+    // The width and maximum height of a page.
+    uint32_t pageSize;
+
+    // The images that store the packed frames.
+    std::vector<std::shared_ptr<Image>> pages;
+
+    // Statistics.
+    size_t numFrames       = 0u;
+    size_t numUniqueFrames = 0u;
+};
+
+}  // namespace Graphics
@@ -16,5 +16,7 @@ struct Vertex
     glm::vec2 position { 0 };
     glm::vec2 texCoord { 0 };
     Color     color { Color::White };
+
+    bool operator==( const Vertex& ) const = default;
 };
 }  // namespace Graphics
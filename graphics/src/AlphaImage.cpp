@@ -0,0 +1,178 @@
+#include <Graphics/AlphaImage.hpp>
+#include <Graphics/Image.hpp>
+
+#include "PixelFormat.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+using namespace Graphics;
+using namespace Math;
+
+namespace
+{
+// Modulo that is always positive (for negative texture coordinates).
+constexpr int wrap( int x, int y ) noexcept
+{
+    const int m = x % y;
+    return m < 0 ? m + y : m;
+}
+}  // namespace
+
+uint64_t AlphaImage::nextGeneration() noexcept
+{
+    static std::atomic<uint64_t> generation { 0u };
+    return generation.fetch_add( 1u, std::memory_order_relaxed ) + 1u;
+}
+
+AlphaImage::AlphaImage( uint32_t width, uint32_t height )
+{
+    resize( width, height );
+}
+
+AlphaImage::AlphaImage( const Image& image )
+{
+    resize( image.getWidth(), image.getHeight() );
+
+    PixelFormat::extractAlpha( data(), image.data(), static_cast<size_t>( m_width ) * m_height );
+}
+
+AlphaImage::AlphaImage( const AlphaImage& copy )
+{
+    resize( copy.m_width, copy.m_height );
+    if ( copy.m_data )
+        std::memcpy( data(), copy.data(), static_cast<size_t>( m_width ) * m_height );
+}
+
+AlphaImage::AlphaImage( AlphaImage&& move ) noexcept
+: m_width { move.m_width }
+, m_height { move.m_height }
+, m_data { std::move( move.m_data ) }
+{
+    move.m_width      = 0u;
+    move.m_height     = 0u;
+    move.m_generation = nextGeneration();
+}
+
+AlphaImage& AlphaImage::operator=( const AlphaImage& image )
+{
+    if ( this == &image )
+        return *this;
+
+    resize( image.m_width, image.m_height );
+    if ( image.m_data )
+        std::memcpy( data(), image.data(), static_cast<size_t>( m_width ) * m_height );
+
+    m_generation = nextGeneration();
+
+    return *this;
+}
+
+AlphaImage& AlphaImage::operator=( AlphaImage&& image ) noexcept
+{
+    m_width      = image.m_width;
+    m_height     = image.m_height;
+    m_data       = std::move( image.m_data );
+    m_generation = nextGeneration();
+
+    image.m_width      = 0u;
+    image.m_height     = 0u;
+    image.m_generation = nextGeneration();
+
+    return *this;
+}
+
+void AlphaImage::resize( uint32_t width, uint32_t height )
+{
+    if ( m_width == width && m_height == height && m_data )
+        return;
+
+    m_width      = width;
+    m_height     = height;
+    m_generation = nextGeneration();
+
+    // Align the buffer to a 64-byte boundary (same as Image) so that rows can be processed with aligned SIMD loads.
+    m_data = make_aligned_unique<uint8_t[], 64>( static_cast<uint64_t>( width ) * height );
+}
+
+void AlphaImage::clear( uint8_t alpha ) noexcept
+{
+    if ( !m_data )
+        return;
+
+    m_generation = nextGeneration();
+
+    std::memset( m_data.get(), alpha, static_cast<size_t>( m_width ) * m_height );
+}
+
+void AlphaImage::blit( const AlphaImage& srcImage, const RectI& srcRect, int x, int y, int step ) noexcept
+{
+    if ( !m_data || !srcImage.m_data || step < 1 )
+        return;
+
+    m_generation = nextGeneration();
+
+    // The destination columns [i0, i1) and rows [j0, j1) that are inside both images.
+    // Destination column i reads source column srcRect.left + i * step.
+    const int w  = ( srcRect.width + step - 1 ) / step;
+    const int i0 = std::max( { 0, -x, ( -srcRect.left + step - 1 ) / step } );
+    const int i1 = std::min( { w, static_cast<int>( m_width ) - x, ( static_cast<int>( srcImage.m_width ) - srcRect.left + step - 1 ) / step } );
+    const int j0 = std::max( { 0, -y, -srcRect.top } );
+    const int j1 = std::min( { srcRect.height, static_cast<int>( m_height ) - y, static_cast<int>( srcImage.m_height ) - srcRect.top } );
+
+    for ( int j = j0; j < j1; ++j )
+    {
+        const uint8_t* src = srcImage.data() + static_cast<size_t>( srcRect.top + j ) * srcImage.m_width + srcRect.left;
+        uint8_t*       dst = m_data.get() + static_cast<size_t>( y + j ) * m_width + x;
+
+        for ( int i = i0; i < i1; ++i )
+            dst[i] = std::max( dst[i], src[i * step] );
+    }
+}
+
+template<AddressMode A>
+uint8_t AlphaImage::sample( int u, int v ) const noexcept
+{
+    const int w = static_cast<int>( m_width );
+    const int h = static_cast<int>( m_height );
+
+    if constexpr ( A == AddressMode::Wrap )
+    {
+        u = wrap( u, w );
+        v = wrap( v, h );
+    }
+    else if constexpr ( A == AddressMode::Mirror )
+    {
+        u = u / w % 2 == 0 ? wrap( u, w ) : ( w - 1 ) - wrap( u, w );
+        v = v / h % 2 == 0 ? wrap( v, h ) : ( h - 1 ) - wrap( v, h );
+    }
+    else if constexpr ( A == AddressMode::Clamp )
+    {
+        u = std::clamp( u, 0, w - 1 );
+        v = std::clamp( v, 0, h - 1 );
+    }
+
+    assert( u >= 0 && u < w );
+    assert( v >= 0 && v < h );
+
+    return m_data[static_cast<uint64_t>( v ) * m_width + u];
+}
+
+template uint8_t AlphaImage::sample<AddressMode::Wrap>( int u, int v ) const noexcept;
+template uint8_t AlphaImage::sample<AddressMode::Mirror>( int u, int v ) const noexcept;
+template uint8_t AlphaImage::sample<AddressMode::Clamp>( int u, int v ) const noexcept;
+
+uint8_t AlphaImage::sample( int u, int v, AddressMode addressMode ) const noexcept
+{
+    switch ( addressMode )
+    {
+    case AddressMode::Wrap:
+        return sample<AddressMode::Wrap>( u, v );
+    case AddressMode::Mirror:
+        return sample<AddressMode::Mirror>( u, v );
+    case AddressMode::Clamp:
+    default:
+        return sample<AddressMode::Clamp>( u, v );
+    }
+}
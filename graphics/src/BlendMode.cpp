@@ -1,8 +1,299 @@
 #include <Graphics/BlendMode.hpp>
 
+#include <emmintrin.h>
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+
 using namespace Graphics;
 
 const BlendMode BlendMode::Disable { false };
 const BlendMode BlendMode::AlphaBlend { true, BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha };
 const BlendMode BlendMode::AdditiveBlend { true, BlendFactor::One, BlendFactor::One };
 const BlendMode BlendMode::SubtractiveBlend { true, BlendFactor::One, BlendFactor::One, BlendOperation::Subtract };
+const BlendMode BlendMode::PremultipliedAlpha { true, BlendFactor::One, BlendFactor::OneMinusSrcAlpha };
+
+BlendPreset BlendMode::getPreset() const noexcept
+{
+    if ( !blendEnable )
+        return BlendPreset::Disable;
+    if ( *this == AlphaBlend )
+        return BlendPreset::AlphaBlend;
+    if ( *this == AdditiveBlend )
+        return BlendPreset::AdditiveBlend;
+    if ( *this == SubtractiveBlend )
+        return BlendPreset::SubtractiveBlend;
+    if ( *this == PremultipliedAlpha )
+        return BlendPreset::PremultipliedAlpha;
+
+    return BlendPreset::Custom;
+}
+
+namespace
+{
+// Reads the source pixels, either from a span or from a single (broadcasted) color.
+struct SpanSource
+{
+    const Color* src;
+
+    const Color& operator[]( size_t i ) const noexcept
+    {
+        return src[i];
+    }
+
+    __m128i load4( size_t i ) const noexcept
+    {
+        return _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i ) );
+    }
+
+#if defined( __AVX2__ )
+    __m256i load8( size_t i ) const noexcept
+    {
+        return _mm256_loadu_si256( reinterpret_cast<const __m256i*>( src + i ) );
+    }
+#endif
+};
+
+struct ColorSource
+{
+    Color color;
+
+    const Color& operator[]( size_t ) const noexcept
+    {
+        return color;
+    }
+
+    __m128i load4( size_t ) const noexcept
+    {
+        return _mm_set1_epi32( static_cast<int>( color.argb ) );
+    }
+
+#if defined( __AVX2__ )
+    __m256i load8( size_t ) const noexcept
+    {
+        return _mm256_set1_epi32( static_cast<int>( color.argb ) );
+    }
+#endif
+};
+
+// Divide 16-bit values in the range [0..255*255] by 255 (rounding down like the scalar blend).
+inline __m128i div255( __m128i x ) noexcept
+{
+    return _mm_srli_epi16( _mm_mulhi_epu16( x, _mm_set1_epi16( static_cast<short>( 0x8081 ) ) ), 7 );
+}
+
+// s * sA / 255 + d * ( 255 - sA ) / 255 for 2 pixels unpacked to 16 bits.
+inline __m128i alphaBlend16( __m128i s, __m128i d ) noexcept
+{
+    const __m128i a    = _mm_shufflehi_epi16( _mm_shufflelo_epi16( s, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    const __m128i invA = _mm_sub_epi16( _mm_set1_epi16( 255 ), a );
+
+    return _mm_add_epi16( div255( _mm_mullo_epi16( s, a ) ), div255( _mm_mullo_epi16( d, invA ) ) );
+}
+
+// d * ( 255 - sA ) / 255 for 2 pixels unpacked to 16 bits.
+inline __m128i invAlphaScale16( __m128i s, __m128i d ) noexcept
+{
+    const __m128i a    = _mm_shufflehi_epi16( _mm_shufflelo_epi16( s, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    const __m128i invA = _mm_sub_epi16( _mm_set1_epi16( 255 ), a );
+
+    return div255( _mm_mullo_epi16( d, invA ) );
+}
+
+// Blend 4 pixels.
+template<BlendPreset P>
+__m128i blend4( __m128i s, __m128i d ) noexcept
+{
+    const __m128i alphaMask = _mm_set1_epi32( static_cast<int>( 0xFF000000 ) );
+
+    __m128i rgb;
+    if constexpr ( P == BlendPreset::AlphaBlend )
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i lo   = alphaBlend16( _mm_unpacklo_epi8( s, zero ), _mm_unpacklo_epi8( d, zero ) );
+        const __m128i hi   = alphaBlend16( _mm_unpackhi_epi8( s, zero ), _mm_unpackhi_epi8( d, zero ) );
+        rgb                = _mm_packus_epi16( lo, hi );
+    }
+    else if constexpr ( P == BlendPreset::PremultipliedAlpha )
+    {
+        // The source is already multiplied by alpha, so only the destination needs to be scaled.
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i lo   = invAlphaScale16( _mm_unpacklo_epi8( s, zero ), _mm_unpacklo_epi8( d, zero ) );
+        const __m128i hi   = invAlphaScale16( _mm_unpackhi_epi8( s, zero ), _mm_unpackhi_epi8( d, zero ) );
+        rgb                = _mm_adds_epu8( s, _mm_packus_epi16( lo, hi ) );
+    }
+    else if constexpr ( P == BlendPreset::AdditiveBlend )
+    {
+        rgb = _mm_adds_epu8( s, d );
+    }
+    else if constexpr ( P == BlendPreset::SubtractiveBlend )
+    {
+        rgb = _mm_subs_epu8( s, d );
+    }
+    else
+    {
+        return s;
+    }
+
+    // The preset blend modes keep the source alpha.
+    return _mm_or_si128( _mm_andnot_si128( alphaMask, rgb ), _mm_and_si128( alphaMask, s ) );
+}
+
+#if defined( __AVX2__ )
+inline __m256i div255( __m256i x ) noexcept
+{
+    return _mm256_srli_epi16( _mm256_mulhi_epu16( x, _mm256_set1_epi16( static_cast<short>( 0x8081 ) ) ), 7 );
+}
+
+inline __m256i alphaBlend16( __m256i s, __m256i d ) noexcept
+{
+    const __m256i a    = _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( s, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    const __m256i invA = _mm256_sub_epi16( _mm256_set1_epi16( 255 ), a );
+
+    return _mm256_add_epi16( div255( _mm256_mullo_epi16( s, a ) ), div255( _mm256_mullo_epi16( d, invA ) ) );
+}
+
+inline __m256i invAlphaScale16( __m256i s, __m256i d ) noexcept
+{
+    const __m256i a    = _mm256_shufflehi_epi16( _mm256_shufflelo_epi16( s, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    const __m256i invA = _mm256_sub_epi16( _mm256_set1_epi16( 255 ), a );
+
+    return div255( _mm256_mullo_epi16( d, invA ) );
+}
+
+// Blend 8 pixels.
+template<BlendPreset P>
+__m256i blend8( __m256i s, __m256i d ) noexcept
+{
+    const __m256i alphaMask = _mm256_set1_epi32( static_cast<int>( 0xFF000000 ) );
+
+    __m256i rgb;
+    if constexpr ( P == BlendPreset::AlphaBlend )
+    {
+        // Unpacking and packing both work within 128-bit lanes, so the pixel order is preserved.
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i lo   = alphaBlend16( _mm256_unpacklo_epi8( s, zero ), _mm256_unpacklo_epi8( d, zero ) );
+        const __m256i hi   = alphaBlend16( _mm256_unpackhi_epi8( s, zero ), _mm256_unpackhi_epi8( d, zero ) );
+        rgb                = _mm256_packus_epi16( lo, hi );
+    }
+    else if constexpr ( P == BlendPreset::PremultipliedAlpha )
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i lo   = invAlphaScale16( _mm256_unpacklo_epi8( s, zero ), _mm256_unpacklo_epi8( d, zero ) );
+        const __m256i hi   = invAlphaScale16( _mm256_unpackhi_epi8( s, zero ), _mm256_unpackhi_epi8( d, zero ) );
+        rgb                = _mm256_adds_epu8( s, _mm256_packus_epi16( lo, hi ) );
+    }
+    else if constexpr ( P == BlendPreset::AdditiveBlend )
+    {
+        rgb = _mm256_adds_epu8( s, d );
+    }
+    else if constexpr ( P == BlendPreset::SubtractiveBlend )
+    {
+        rgb = _mm256_subs_epu8( s, d );
+    }
+    else
+    {
+        return s;
+    }
+
+    return _mm256_or_si256( _mm256_andnot_si256( alphaMask, rgb ), _mm256_and_si256( alphaMask, s ) );
+}
+#endif
+
+template<BlendPreset P, typename Source>
+void blend( Color* dst, const Source& src, size_t count, const BlendMode& blendMode ) noexcept
+{
+    size_t i = 0;
+
+    if constexpr ( P != BlendPreset::Custom )
+    {
+#if defined( __AVX2__ )
+        for ( ; i + 8 <= count; i += 8 )
+        {
+            __m256i* d = reinterpret_cast<__m256i*>( dst + i );
+            _mm256_storeu_si256( d, blend8<P>( src.load8( i ), _mm256_loadu_si256( d ) ) );
+        }
+#endif
+
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            __m128i* d = reinterpret_cast<__m128i*>( dst + i );
+            _mm_storeu_si128( d, blend4<P>( src.load4( i ), _mm_loadu_si128( d ) ) );
+        }
+    }
+
+    // Scalar path for the remaining pixels.
+    for ( ; i < count; ++i )
+    {
+        dst[i] = blendPixel<P>( src[i], dst[i], blendMode );
+    }
+}
+}  // namespace
+
+template<BlendPreset P>
+void Graphics::blendSpan( Color* dst, const Color* src, size_t count, const BlendMode& blendMode ) noexcept
+{
+    blend<P>( dst, SpanSource { src }, count, blendMode );
+}
+
+template<BlendPreset P>
+void Graphics::blendSpan( Color* dst, const Color& src, size_t count, const BlendMode& blendMode ) noexcept
+{
+    blend<P>( dst, ColorSource { src }, count, blendMode );
+}
+
+template void Graphics::blendSpan<BlendPreset::Disable>( Color*, const Color*, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::AlphaBlend>( Color*, const Color*, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::AdditiveBlend>( Color*, const Color*, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::SubtractiveBlend>( Color*, const Color*, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::PremultipliedAlpha>( Color*, const Color*, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::Custom>( Color*, const Color*, size_t, const BlendMode& ) noexcept;
+
+template void Graphics::blendSpan<BlendPreset::Disable>( Color*, const Color&, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::AlphaBlend>( Color*, const Color&, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::AdditiveBlend>( Color*, const Color&, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::SubtractiveBlend>( Color*, const Color&, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::PremultipliedAlpha>( Color*, const Color&, size_t, const BlendMode& ) noexcept;
+template void Graphics::blendSpan<BlendPreset::Custom>( Color*, const Color&, size_t, const BlendMode& ) noexcept;
+
+namespace
+{
+// Dispatch to the blend preset of the blend mode.
+template<typename Source>
+void dispatch( Color* dst, const Source& src, size_t count, const BlendMode& blendMode ) noexcept
+{
+    switch ( blendMode.getPreset() )
+    {
+    case BlendPreset::Disable:
+        blendSpan<BlendPreset::Disable>( dst, src, count, blendMode );
+        break;
+    case BlendPreset::AlphaBlend:
+        blendSpan<BlendPreset::AlphaBlend>( dst, src, count, blendMode );
+        break;
+    case BlendPreset::AdditiveBlend:
+        blendSpan<BlendPreset::AdditiveBlend>( dst, src, count, blendMode );
+        break;
+    case BlendPreset::SubtractiveBlend:
+        blendSpan<BlendPreset::SubtractiveBlend>( dst, src, count, blendMode );
+        break;
+    case BlendPreset::PremultipliedAlpha:
+        blendSpan<BlendPreset::PremultipliedAlpha>( dst, src, count, blendMode );
+        break;
+    case BlendPreset::Custom:
+        blendSpan<BlendPreset::Custom>( dst, src, count, blendMode );
+        break;
+    }
+}
+}  // namespace
+
+void Graphics::blendSpan( Color* dst, const Color* src, size_t count, const BlendMode& blendMode ) noexcept
+{
+    dispatch( dst, src, count, blendMode );
+}
+
+void Graphics::blendSpan( Color* dst, const Color& src, size_t count, const BlendMode& blendMode ) noexcept
+{
+    dispatch( dst, src, count, blendMode );
+}
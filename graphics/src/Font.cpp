@@ -1,185 +1,565 @@
 
-#include <Graphics/File.hpp>
+#include <Graphics/AlphaImage.hpp>
 #include <Graphics/Font.hpp>
+#include <Graphics/GlyphAtlas.hpp>
 #include <Graphics/Image.hpp>
+#include <Graphics/SDFStyle.hpp>
+
+#include "TextCache.hpp"
+#include "Utf8.hpp"
 
 #include <stb_easy_font.h>
 
-#include <codecvt>
-#include <iostream>
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <string>
 #include <vector>
 
-namespace fs = std::filesystem;
 using namespace Graphics;
 
 const Font Font::Default {};
 
-// Convert wchar_t string to char string.
-static std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> stringConverter;
-
 struct FontVertex
 {
     float   x, y, z;
     uint8_t color[4];
 };
 
+namespace
+{
+// The position of a glyph on the screen and the rectangle of its pixels in the font image.
+struct GlyphQuad
+{
+    int         x, y;
+    Math::RectI rect;
+};
+
+// Place a glyph at the pen position and advance the pen.
+// Glyphs are snapped to whole pixels (the same rounding as stbtt_GetPackedQuad).
+// Oversampled glyphs are snapped to the nearest sub-pixel instead: the rectangle starts at the
+// oversampled column that lines up with the first whole pixel covered by the glyph.
+GlyphQuad placeGlyph( const stbtt_packedchar& c, int oversampling, float& xPos, float yPos ) noexcept
+{
+    const int sx = static_cast<int>( std::floor( ( xPos + c.xoff ) * static_cast<float>( oversampling ) + 0.5f ) );
+    const int x  = sx >= 0 ? ( sx + oversampling - 1 ) / oversampling : -( -sx / oversampling );
+    const int y  = static_cast<int>( std::floor( yPos + c.yoff + 0.5f ) );
+
+    const int phase = x * oversampling - sx;
+
+    xPos += c.xadvance;
+
+    return { x, y, { c.x0 + phase, c.y0, c.x1 - c.x0 - phase, c.y1 - c.y0 } };
+}
+
+// Dilate the coverage mask of a text run by one pixel in each direction.
+std::shared_ptr<const AlphaImage> createOutline( const AlphaImage& mask )
+{
+    const int w = static_cast<int>( mask.getWidth() );
+    const int h = static_cast<int>( mask.getHeight() );
+
+    auto outline = std::make_shared<AlphaImage>( static_cast<uint32_t>( w + 2 ), static_cast<uint32_t>( h + 2 ) );
+    outline->clear();
+
+    // The mask pixel (x, y) is at (x + 1, y + 1) in the outline,
+    // so blitting the mask at each offset of a 3x3 neighborhood dilates it.
+    for ( int j = 0; j < 3; ++j )
+    {
+        for ( int i = 0; i < 3; ++i )
+            outline->blit( mask, mask.getRect(), i, j );
+    }
+
+    return outline;
+}
+
+// The style of distance field text with a single color.
+SDFStyle distanceFieldStyle( const Color& color ) noexcept
+{
+    SDFStyle style;
+    style.color         = color;
+    style.edge          = GlyphAtlas::DistanceFieldEdge;
+    style.distanceScale = GlyphAtlas::DistanceFieldScale;
+    return style;
+}
+}  // namespace
+
 Font::Font( float size )
 : size { size }
+, textCache { std::make_unique<TextCache>() }
+{
+    bakeEasyFont();
+}
+
+Font::Font( const std::filesystem::path& fontFile, float size, uint32_t firstChar, uint32_t numChars, uint32_t oversampling, GlyphMode glyphMode )
+: Font( std::make_shared<GlyphAtlas>( fontFile ), size, firstChar, numChars, oversampling, glyphMode )
 {}
 
-Font::Font( const std::filesystem::path& fontFile, float size, uint32_t firstChar, uint32_t numChars )
+Font::Font( std::shared_ptr<GlyphAtlas> _glyphAtlas, float size, uint32_t firstChar, uint32_t numChars, uint32_t oversampling, GlyphMode glyphMode )
 : size { size }
 , firstChar { firstChar }
 , numChars { numChars }
+, lineHeight { size }
+, textCache { std::make_unique<TextCache>() }
 {
-    if ( fs::exists( fontFile ) && fs::is_regular_file( fontFile ) )
+    if ( _glyphAtlas && *_glyphAtlas )
     {
-        bakedChar = std::make_unique<stbtt_bakedchar[]>( numChars );
-        fontData  = File::readFile<unsigned char>( fontFile, std::ios::binary );
+        glyphAtlas      = std::move( _glyphAtlas );
+        this->glyphMode = glyphMode;
 
-        stbtt_InitFont( &fontInfo, fontData.data(), 0 );
-        // int x0, y0, x1, y1;
-        // stbtt_GetFontBoundingBox( &fontInfo, &x0, &y0, &x1, &y1 );
-        // float scale = stbtt_ScaleForPixelHeight( &fontInfo, size );
+        if ( glyphMode == GlyphMode::DistanceField )
+        {
+            // Distance field glyphs are shared by all sizes of the font and scaled when they are drawn.
+            glyphRange = glyphAtlas->addDistanceFieldRange( firstChar, numChars );
+            glyphScale = size / GlyphAtlas::DistanceFieldSize;
+        }
+        else
+        {
+            glyphRange         = glyphAtlas->addRange( size, firstChar, numChars, oversampling );
+            this->oversampling = glyphAtlas->getRange( glyphRange ).oversampling;
+        }
+    }
+    else
+    {
+        // Fall back to the default font.
+        bakeEasyFont();
+    }
+}
+
+void Font::bakeEasyFont()
+{
+    // stb_easy_font supports the printable ASCII characters.
+    firstChar  = 32u;
+    numChars   = 95u;
+    lineHeight = 12.0f * size;
+
+    // The (scaled) quads of each character and the bounds of the pixels they cover.
+    struct Glyph
+    {
+        std::vector<glm::vec2> vertices;
+        int                    x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    };
+
+    std::vector<Glyph>      chars( numChars );
+    std::vector<FontVertex> vertexBuffer( 1024 );
+
+    int cellW = 1;
+    int cellH = 1;
+
+    for ( uint32_t i = 0; i < numChars; ++i )
+    {
+        char text[2] = { static_cast<char>( firstChar + i ), '\0' };
 
-        // I'm not sure how to calculate the exact size of the pixel buffer needed for the font.
-        // This pixel width is very liberal, but better safe than sorry.
-        const int pw         = static_cast<int>( std::ceil( static_cast<float>( numChars ) * size ) );
-        const int ph         = static_cast<int>( std::ceil( 2.0f * size ) );
-        auto      fontBitmap = std::make_unique<unsigned char[]>( static_cast<size_t>( pw ) * ph );
+        const int numQuads = stb_easy_font_print( 0, 0, text, nullptr, vertexBuffer.data(), static_cast<int>( vertexBuffer.size() * sizeof( FontVertex ) ) );
+        if ( numQuads <= 0 )
+            continue;
 
-        int numRows = stbtt_BakeFontBitmap( fontData.data(), 0, size, fontBitmap.get(), pw, ph,
-                                            static_cast<int>( firstChar ), static_cast<int>( numChars ), bakedChar.get() );
+        Glyph& glyph = chars[i];
 
-        // Copy the alpha values of the font bitmap to the font image.
-        fontImage = std::make_unique<Image>( pw, ph );
-        Color* c  = fontImage->data();
-        for ( int y = 0; y < ph; ++y )
+        float minX = FLT_MAX, minY = FLT_MAX;
+        float maxX = -FLT_MAX, maxY = -FLT_MAX;
+        for ( int j = 0; j < numQuads * 4; j += 4 )
         {
-            for ( int x = 0; x < pw; ++x )
-            {
-                size_t        i = static_cast<size_t>( y ) * pw + x;
-                unsigned char a = fontBitmap[i];
+            // The quads are axis-aligned rectangles. The pixels on the right and bottom edges of a quad are part of the stroke,
+            // so the quad is extended by one pixel to cover them (pixels are sampled at their centers).
+            const glm::vec2 q0 { vertexBuffer[j + 0].x * size, vertexBuffer[j + 0].y * size };
+            const glm::vec2 q1 { vertexBuffer[j + 2].x * size + 1.0f, vertexBuffer[j + 2].y * size + 1.0f };
 
-                c[i] = Color { 255, 255, 255, a };
-            }
+            glyph.vertices.push_back( { q0.x, q0.y } );
+            glyph.vertices.push_back( { q1.x, q0.y } );
+            glyph.vertices.push_back( { q1.x, q1.y } );
+            glyph.vertices.push_back( { q0.x, q1.y } );
+
+            minX = std::min( minX, q0.x );
+            minY = std::min( minY, q0.y );
+            maxX = std::max( maxX, q1.x );
+            maxY = std::max( maxY, q1.y );
         }
 
-        // Uncomment the next lines to save the font image to disk.
-        // This is mostly used for testing the font baking.
-        // auto fontTga = std::format( "{}/{}_{}.tga", fontFile.parent_path().string(), fontFile.stem().string(), size );
-        // fontImage->save( fontTga );
+        // Glyphs are only translated by whole pixels, so they cover the same pixels as their quads.
+        glyph.x0 = static_cast<int>( std::floor( minX ) );
+        glyph.y0 = static_cast<int>( std::floor( minY ) );
+        glyph.x1 = static_cast<int>( std::ceil( maxX ) );
+        glyph.y1 = static_cast<int>( std::ceil( maxY ) );
+
+        cellW = std::max( cellW, glyph.x1 - glyph.x0 );
+        cellH = std::max( cellH, glyph.y1 - glyph.y0 );
     }
-    else
+
+    // Rasterize the glyphs into a grid of cells in the font image.
+    constexpr uint32_t columns = 16u;
+    const uint32_t     rows    = ( numChars + columns - 1 ) / columns;
+
+    Image glyphImage { columns * cellW, rows * cellH };
+    glyphImage.clear( Color { 255, 255, 255, 0 } );
+
+    fontChars.resize( numChars );
+
+    for ( uint32_t i = 0; i < numChars; ++i )
     {
-        std::cerr << "Error reading file: " << fontFile << std::endl;
+        const Glyph& glyph = chars[i];
+        const int    cx    = static_cast<int>( i % columns ) * cellW;
+        const int    cy    = static_cast<int>( i / columns ) * cellH;
+
+        const glm::vec2 offset { static_cast<float>( cx - glyph.x0 ), static_cast<float>( cy - glyph.y0 ) };
+        for ( size_t j = 0; j < glyph.vertices.size(); j += 4 )
+        {
+            glyphImage.drawQuad( glyph.vertices[j + 0] + offset, glyph.vertices[j + 1] + offset, glyph.vertices[j + 2] + offset, glyph.vertices[j + 3] + offset, Color::White, {}, FillMode::Solid );
+        }
+
+        stbtt_packedchar& c = fontChars[i];
+        c.x0                = static_cast<unsigned short>( cx );
+        c.y0                = static_cast<unsigned short>( cy );
+        c.x1                = static_cast<unsigned short>( cx + glyph.x1 - glyph.x0 );
+        c.y1                = static_cast<unsigned short>( cy + glyph.y1 - glyph.y0 );
+        c.xoff              = static_cast<float>( glyph.x0 );
+        c.yoff              = static_cast<float>( glyph.y0 );
+        c.xoff2             = static_cast<float>( glyph.x1 );
+        c.yoff2             = static_cast<float>( glyph.y1 );
+        c.xadvance          = ( static_cast<float>( stb_easy_font_charinfo[i].advance & 15 ) + stb_easy_font_spacing_val ) * size;
     }
+
+    // Only the coverage of the glyphs is kept.
+    fontImage = std::make_shared<AlphaImage>( glyphImage );
+}
+
+glm::vec2 Font::getSize( std::string_view text ) const
+{
+    const Math::RectF bounds = getBounds( text );
+    return { bounds.width, bounds.height };
+}
+
+Math::RectF Font::getBounds( std::string_view text ) const
+{
+    if ( const Math::RectF* bounds = textCache->findBounds( text ) )
+        return *bounds;
+
+    const Math::RectF bounds = measure( text );
+    textCache->insertBounds( text, bounds );
+
+    return bounds;
 }
 
-glm::vec2 Font::getSize( std::string_view text ) const noexcept
+Math::RectF Font::measure( std::string_view text ) const noexcept
 {
-    float width  = 0.0f;
-    float height = 0.0f;
+    if ( !getFontImage() )
+        return {};
 
-    if ( fontImage && bakedChar )
+    // Placing the glyphs gives the exact pixels that are covered by the text.
+    // Glyphs are placed in the space of the font image (the padding around distance field glyphs is not part of the text).
+    const int  inset = glyphMode == GlyphMode::DistanceField ? GlyphAtlas::DistanceFieldPadding : 0;
+    const int  step  = static_cast<int>( oversampling );
+    Math::AABB aabb;
+    float      xPos = 0.0f;
+    float      yPos = 0.0f;
+    for ( const char32_t t: Utf8View { text } )
     {
-        // TODO: There must be a better way of computing the size of the text using font metrics.
-        // But using GetBakedQuad seems like the most obvious (but not optimal) approach.
-        Math::AABB  aabb;
-        const char* t    = text.data();
-        float       xPos = 0.0f;
-        float       yPos = 0.0f;
-        while ( *t )
+        if ( const stbtt_packedchar* c = getGlyph( t ) )
         {
-            if ( *t >= firstChar && *t < ( firstChar + numChars ) )
-            {
-                stbtt_aligned_quad q;
-                stbtt_GetBakedQuad( bakedChar.get(), static_cast<int>( fontImage->getWidth() ), static_cast<int>( fontImage->getHeight() ), *t - firstChar, &xPos, &yPos, &q, 1 );
-                aabb.expand( Math::AABB::fromMinMax( { q.x0, q.y0, 0 }, { q.x1, q.y1, 0 } ) );
-            }
-            else if ( *t == '\n' )
-            {
-                xPos = 0.0f;
-                yPos += size;
-            }
-
-            ++t;
+            const GlyphQuad q = placeGlyph( *c, step, xPos, yPos );
+            const int       w = ( q.rect.width + step - 1 ) / step;
+            if ( w > 2 * inset && q.rect.height > 2 * inset )
+                aabb.expand( Math::AABB::fromMinMax( { static_cast<float>( q.x + inset ), static_cast<float>( q.y + inset ), 0 }, { static_cast<float>( q.x + w - inset ), static_cast<float>( q.y + q.rect.height - inset ), 0 } ) );
+            else if ( inset == 0 )
+                aabb.expand( Math::AABB::fromMinMax( { static_cast<float>( q.x ), static_cast<float>( q.y ), 0 }, { static_cast<float>( q.x + w ), static_cast<float>( q.y + q.rect.height ), 0 } ) );
+        }
+        else if ( t == '\n' )
+        {
+            xPos = 0.0f;
+            yPos += lineHeight / glyphScale;
         }
-        width  = aabb.width();
-        height = aabb.height();
     }
-    else
+
+    if ( !aabb.isValid() )
+        return {};
+
+    return { aabb.min.x * glyphScale, aabb.min.y * glyphScale, aabb.width() * glyphScale, aabb.height() * glyphScale };
+}
+
+float Font::getLineWidth( std::string_view text ) const noexcept
+{
+    float width = 0.0f;
+    for ( const char32_t t: Utf8View { text } )
     {
-        width  = static_cast<float>( stb_easy_font_width( text.data() ) ) * size;
-        height = static_cast<float>( stb_easy_font_height( text.data() ) ) * size;
+        if ( const stbtt_packedchar* c = getGlyph( t ) )
+            width += c->xadvance;
     }
 
-    return { width, height };
+    return width * glyphScale;
 }
 
-void Font::drawText( Image& image, std::string_view text, int x, int y, const Color& color ) const
+glm::vec2 Font::getCenteredPosition( std::string_view text, const glm::vec2& center ) const
 {
-    // Convert to wide character strings.
-    std::wstring wText = stringConverter.from_bytes( text.data() );
-    drawText( image, wText, x, y, color );
+    const Math::RectF bounds = getBounds( text );
+
+    // Text is drawn at whole pixels.
+    return { std::floor( center.x - bounds.left - bounds.width * 0.5f + 0.5f ), std::floor( center.y - bounds.top - bounds.height * 0.5f + 0.5f ) };
 }
 
-void Font::drawText( Image& image, std::wstring_view text, int x, int y, const Color& color ) const
+void Font::wrapText( std::string_view text, float width, std::vector<std::string_view>& lines ) const
 {
-    if ( fontImage && bakedChar )
+    lines.clear();
+
+    // Lines are measured with the advances of the glyphs (in the space of the font image).
+    const float maxWidth  = width / glyphScale;
+    const char* lineStart = text.data();
+    const char* space     = nullptr;  // The last space on the current line.
+    float       xPos      = 0.0f;     // The pen position relative to the start of the line.
+    float       xSpace    = 0.0f;     // The pen position after the last space.
+
+    const Utf8View view { text };
+    for ( auto iter = view.begin(); iter != view.end(); ++iter )
     {
-        const wchar_t* t    = text.data();
-        auto           xPos = static_cast<float>( x );
-        auto           yPos = static_cast<float>( y );
-        while ( *t )
+        const char32_t t   = *iter;
+        const char*    pos = iter.position();
+
+        if ( t == '\n' )
         {
-            if ( *t >= firstChar && *t < ( firstChar + numChars ) )
-            {
-                stbtt_aligned_quad q;
-                stbtt_GetBakedQuad( bakedChar.get(), static_cast<int>( fontImage->getWidth() ), static_cast<int>( fontImage->getHeight() ), static_cast<int>( *t - firstChar ), &xPos, &yPos, &q, 1 );
+            lines.emplace_back( lineStart, static_cast<size_t>( pos - lineStart ) );
+            lineStart = pos + 1;
+            space     = nullptr;
+            xPos      = 0.0f;
+            continue;
+        }
 
-                Vertex v0 { { q.x0, q.y0 }, { q.s0, q.t0 }, color };
-                Vertex v1 { { q.x1, q.y0 }, { q.s1, q.t0 }, color };
-                Vertex v2 { { q.x1, q.y1 }, { q.s1, q.t1 }, color };
-                Vertex v3 { { q.x0, q.y1 }, { q.s0, q.t1 }, color };
+        const stbtt_packedchar* c       = getGlyph( t );
+        const float             advance = c ? c->xadvance : 0.0f;
 
-                image.drawQuad( v0, v1, v2, v3, *fontImage, AddressMode::Clamp, BlendMode::AlphaBlend );
-                // image.drawQuad( { q.x0, q.y0 }, { q.x1, q.y0 }, { q.x1, q.y1 }, { q.x0, q.y1 }, Color::Red, {}, FillMode::WireFrame ); // For debugging glyph quads.
-            }
-            else if ( *t == '\n' )
-            {
-                xPos = static_cast<float>( x );
-                yPos += size;
-            }
+        if ( t == ' ' )
+        {
+            // Spaces at the end of a line may stick out of the line.
+            space  = pos;
+            xPos  += advance;
+            xSpace = xPos;
+            continue;
+        }
 
-            ++t;
+        // Break the line at the last space if the glyph doesn't fit.
+        if ( xPos + advance > maxWidth && space )
+        {
+            lines.emplace_back( lineStart, static_cast<size_t>( space - lineStart ) );
+            lineStart = space + 1;
+            space     = nullptr;
+            xPos -= xSpace;
         }
+
+        xPos += advance;
     }
+
+    lines.emplace_back( lineStart, static_cast<size_t>( text.data() + text.size() - lineStart ) );
+}
+
+Font::~Font() = default;
+
+const std::shared_ptr<const AlphaImage>& Font::getFontImage() const noexcept
+{
+    if ( !glyphAtlas )
+        return fontImage;
+
+    return glyphMode == GlyphMode::DistanceField ? glyphAtlas->getDistanceFieldImage() : glyphAtlas->getImage();
+}
+
+const stbtt_packedchar* Font::getGlyph( uint32_t c ) const noexcept
+{
+    if ( c < firstChar || c >= firstChar + numChars )
+        return nullptr;
+
+    return glyphAtlas ? &glyphAtlas->getRange( glyphRange ).chars[c - firstChar] : &fontChars[c - firstChar];
+}
+
+void Font::drawText( Image& image, std::string_view text, int x, int y, const Color& color ) const
+{
+    // Text that is only drawn once (or that changes every frame) is not worth rasterizing into a run.
+    if ( getFontImage() && !textCache->find( text ) && !textCache->admit( text ) )
+    {
+        drawGlyphs( image, text, x, y, color );
+        return;
+    }
+
+    const TextRun& run = getTextRun( text );
+    if ( !run.mask )
+        return;
+
+    if ( glyphMode == GlyphMode::DistanceField )
+        image.drawSDF( run.mask, run.mask->getRect(), runPosition( run, x, y ), glyphScale, distanceFieldStyle( color ) );
     else
+        image.drawMask( run.mask, run.mask->getRect(), x + run.offset.x, y + run.offset.y, color );
+}
+
+void Font::drawText( Image& image, std::wstring_view text, int x, int y, const Color& color ) const
+{
+    // Text runs are cached by their UTF-8 string.
+    // The string is reused, so converting the text doesn't allocate once the string is large enough.
+    thread_local std::string utf8;
+    toUtf8( text, utf8 );
+    drawText( image, utf8, x, y, color );
+}
+
+void Font::drawTextShadow( Image& image, std::string_view text, int x, int y, const Color& color, const Color& shadowColor, const glm::ivec2& shadowOffset ) const
+{
+    if ( glyphMode == GlyphMode::DistanceField )
+    {
+        // The shadow and the text are drawn in a single pass.
+        const TextRun& run = getTextRun( text );
+        if ( !run.mask )
+            return;
+
+        SDFStyle style     = distanceFieldStyle( color );
+        style.shadowColor  = shadowColor;
+        style.shadowOffset = shadowOffset;
+        image.drawSDF( run.mask, run.mask->getRect(), runPosition( run, x, y ), glyphScale, style );
+        return;
+    }
+
+    if ( getFontImage() && !textCache->find( text ) && !textCache->admit( text ) )
+    {
+        drawGlyphs( image, text, x + shadowOffset.x, y + shadowOffset.y, shadowColor );
+        drawGlyphs( image, text, x, y, color );
+        return;
+    }
+
+    const TextRun& run = getTextRun( text );
+    if ( !run.mask )
+        return;
+
+    // The shadow and the text are drawn from the same mask.
+    image.drawMask( run.mask, run.mask->getRect(), x + run.offset.x + shadowOffset.x, y + run.offset.y + shadowOffset.y, shadowColor );
+    image.drawMask( run.mask, run.mask->getRect(), x + run.offset.x, y + run.offset.y, color );
+}
+
+void Font::drawTextOutline( Image& image, std::string_view text, int x, int y, const Color& color, const Color& outlineColor ) const
+{
+    TextRun& run = getTextRun( text );
+    if ( !run.mask )
+        return;
+
+    if ( glyphMode == GlyphMode::DistanceField )
     {
-        // Basic fonts only support ASCII characters. Try to convert the text to ASCII...
-        std::string strText = stringConverter.to_bytes( text.data() );
+        // The outline is part of the distance field, so it doesn't need a separate mask.
+        SDFStyle style     = distanceFieldStyle( color );
+        style.outlineColor = outlineColor;
+        style.outlineWidth = 1.0f;
+        image.drawSDF( run.mask, run.mask->getRect(), runPosition( run, x, y ), glyphScale, style );
+        return;
+    }
 
-        std::vector<FontVertex> vertexBuffer( text.length() * 40 );
+    if ( !run.outline )
+        run.outline = createOutline( *run.mask );
 
-        const int numQuads = stb_easy_font_print( 0, 0, strText.data(), nullptr, vertexBuffer.data(), static_cast<int>( vertexBuffer.size() * sizeof( FontVertex ) ) );
+    image.drawMask( run.outline, run.outline->getRect(), x + run.offset.x - 1, y + run.offset.y - 1, outlineColor );
+    image.drawMask( run.mask, run.mask->getRect(), x + run.offset.x, y + run.offset.y, color );
+}
+
+void Font::drawGlyphs( Image& image, std::string_view text, int x, int y, const Color& color ) const
+{
+    const auto& glyphImage = getFontImage();
 
-        // Scale the quads.
-        for ( auto& v: vertexBuffer )
+    if ( glyphMode == GlyphMode::DistanceField )
+    {
+        // Glyphs are placed in the space of the distance field and scaled to the screen.
+        const SDFStyle style = distanceFieldStyle( color );
+
+        float xPos = 0.0f;
+        float yPos = 0.0f;
+        for ( const char32_t t: Utf8View { text } )
         {
-            v.x = v.x * size + static_cast<float>( x );
-            v.y = v.y * size + static_cast<float>( y );
-            v.z = v.z * size;
+            if ( const stbtt_packedchar* c = getGlyph( t ) )
+            {
+                const GlyphQuad q = placeGlyph( *c, 1, xPos, yPos );
+                if ( q.rect.width > 0 && q.rect.height > 0 )
+                    image.drawSDF( glyphImage, q.rect, { static_cast<float>( x ) + static_cast<float>( q.x ) * glyphScale, static_cast<float>( y ) + static_cast<float>( q.y ) * glyphScale }, glyphScale, style );
+            }
+            else if ( t == '\n' )
+            {
+                xPos = 0.0f;
+                yPos += lineHeight / glyphScale;
+            }
         }
+        return;
+    }
 
-        for ( int i = 0; i < numQuads; ++i )
+    auto xPos = static_cast<float>( x );
+    auto yPos = static_cast<float>( y );
+    for ( const char32_t t: Utf8View { text } )
+    {
+        if ( const stbtt_packedchar* c = getGlyph( t ) )
+        {
+            // Each glyph is an unscaled copy of its rectangle in the font image
+            // (only every n-th column is drawn for oversampled glyphs).
+            const GlyphQuad q = placeGlyph( *c, static_cast<int>( oversampling ), xPos, yPos );
+            image.drawMask( glyphImage, q.rect, q.x, q.y, color, static_cast<int>( oversampling ) );
+        }
+        else if ( t == '\n' )
         {
-            const FontVertex& v0 = vertexBuffer[i * 4 + 0];
-            const FontVertex& v1 = vertexBuffer[i * 4 + 1];
-            const FontVertex& v2 = vertexBuffer[i * 4 + 2];
-            const FontVertex& v3 = vertexBuffer[i * 4 + 3];
+            xPos = static_cast<float>( x );
+            yPos += lineHeight;
+        }
+    }
+}
 
-            image.drawQuad( { v0.x, v0.y }, { v1.x, v1.y }, { v2.x, v2.y }, { v3.x, v3.y }, color, {}, FillMode::Solid );
+glm::vec2 Font::runPosition( const TextRun& run, int x, int y ) const noexcept
+{
+    return { static_cast<float>( x ) + static_cast<float>( run.offset.x ) * glyphScale, static_cast<float>( y ) + static_cast<float>( run.offset.y ) * glyphScale };
+}
+
+TextRun& Font::getTextRun( std::string_view text ) const
+{
+    if ( TextRun* run = textCache->find( text ) )
+        return *run;
+
+    return textCache->insert( std::string { text }, createTextRun( text ) );
+}
+
+TextRun Font::createTextRun( std::string_view text ) const
+{
+    const auto& glyphImage = getFontImage();
+    if ( !glyphImage )
+        return {};
+
+    const int step = static_cast<int>( oversampling );
+
+    std::vector<GlyphQuad> glyphs;
+    glyphs.reserve( text.size() );
+
+    int minX = INT_MAX, minY = INT_MAX;
+    int maxX = INT_MIN, maxY = INT_MIN;
+
+    float xPos = 0.0f;
+    float yPos = 0.0f;
+    for ( const char32_t t: Utf8View { text } )
+    {
+        if ( const stbtt_packedchar* c = getGlyph( t ) )
+        {
+            // Glyphs are axis-aligned, unscaled, and snapped to whole pixels.
+            const GlyphQuad q = placeGlyph( *c, step, xPos, yPos );
+            const int       w = ( q.rect.width + step - 1 ) / step;
+
+            if ( w > 0 && q.rect.height > 0 )
+            {
+                minX = std::min( minX, q.x );
+                minY = std::min( minY, q.y );
+                maxX = std::max( maxX, q.x + w );
+                maxY = std::max( maxY, q.y + q.rect.height );
+                glyphs.push_back( q );
+            }
+        }
+        else if ( t == '\n' )
+        {
+            xPos = 0.0f;
+            yPos += lineHeight / glyphScale;
         }
     }
+
+    if ( glyphs.empty() )
+        return {};
+
+    auto mask = std::make_shared<AlphaImage>( static_cast<uint32_t>( maxX - minX ), static_cast<uint32_t>( maxY - minY ) );
+    mask->clear();
+
+    // Combine the coverage of the glyphs (neighboring glyphs may overlap).
+    // The maximum of the distance fields of the glyphs is also the distance field of their union.
+    for ( const GlyphQuad& q: glyphs )
+        mask->blit( *glyphImage, q.rect, q.x - minX, q.y - minY, step );
+
+    return { std::move( mask ), { minX, minY }, nullptr };
 }
@@ -7,7 +7,7 @@ out vec4 color;
 
 void main()
 {
-    color = textureLod(tex, uv, 0).bgra;
+    color = textureLod(tex, uv, 0);
     // color = vec4(uv, 0, 0);
 }
 )"
\ No newline at end of file
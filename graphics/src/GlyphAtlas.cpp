@@ -0,0 +1,341 @@
+#include <Graphics/File.hpp>
+#include <Graphics/GlyphAtlas.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+namespace fs = std::filesystem;
+using namespace Graphics;
+
+namespace
+{
+// The space between the glyphs in the atlas (in pixels).
+// stbtt_PackFontRanges needs at least one pixel to pack glyphs without pixels (like the space character).
+constexpr int Padding = 1;
+
+// The maximum height of the atlas image.
+constexpr int MaxHeight = 16384;
+
+// Frees the distance field of a glyph.
+struct SDFDeleter
+{
+    void operator()( unsigned char* sdf ) const noexcept
+    {
+        stbtt_FreeSDF( sdf, nullptr );
+    }
+};
+}  // namespace
+
+GlyphAtlas::GlyphAtlas( const std::filesystem::path& fontFile )
+{
+    if ( !fs::exists( fontFile ) || !fs::is_regular_file( fontFile ) )
+    {
+        std::cerr << "Error reading file: " << fontFile << std::endl;
+        return;
+    }
+
+    fontData = File::readFile<unsigned char>( fontFile, std::ios::binary );
+
+    if ( !stbtt_InitFont( &fontInfo, fontData.data(), 0 ) )
+    {
+        std::cerr << "Invalid font file: " << fontFile << std::endl;
+        fontData.clear();
+    }
+}
+
+size_t GlyphAtlas::addRange( float size, uint32_t firstChar, uint32_t numChars, uint32_t oversampling )
+{
+    oversampling = std::clamp( oversampling, 1u, 8u );
+
+    const auto iter = std::find_if( ranges.begin(), ranges.end(), [&]( const Range& r ) {
+        return !r.distanceField && r.size == size && r.firstChar == firstChar && r.numChars == numChars && r.oversampling == oversampling;
+    } );
+
+    if ( iter != ranges.end() )
+        return static_cast<size_t>( iter - ranges.begin() );
+
+    ranges.push_back( { size, firstChar, numChars, oversampling, std::vector<stbtt_packedchar>( numChars ) } );
+
+    if ( *this )
+        pack();
+
+    return ranges.size() - 1;
+}
+
+size_t GlyphAtlas::addDistanceFieldRange( uint32_t firstChar, uint32_t numChars )
+{
+    const auto iter = std::find_if( ranges.begin(), ranges.end(), [&]( const Range& r ) {
+        return r.distanceField && r.firstChar == firstChar && r.numChars == numChars;
+    } );
+
+    if ( iter != ranges.end() )
+        return static_cast<size_t>( iter - ranges.begin() );
+
+    ranges.push_back( { DistanceFieldSize, firstChar, numChars, 1u, std::vector<stbtt_packedchar>( numChars ), true } );
+
+    if ( *this )
+        packDistanceField( ranges.back() );
+
+    return ranges.size() - 1;
+}
+
+size_t GlyphAtlas::getNumGlyphs() const noexcept
+{
+    size_t numGlyphs = 0;
+    for ( const Range& range: ranges )
+        numGlyphs += range.numChars;
+
+    return numGlyphs;
+}
+
+size_t GlyphAtlas::getGlyphArea() const noexcept
+{
+    size_t area = 0;
+    for ( const Range& range: ranges )
+    {
+        for ( const stbtt_packedchar& c: range.chars )
+            area += static_cast<size_t>( c.x1 - c.x0 ) * ( c.y1 - c.y0 );
+    }
+
+    return area;
+}
+
+float GlyphAtlas::getOccupancy() const noexcept
+{
+    size_t imageArea = 0;
+    for ( const auto& img: { image, distanceFieldImage } )
+    {
+        if ( img )
+            imageArea += static_cast<size_t>( img->getWidth() ) * img->getHeight();
+    }
+
+    if ( imageArea == 0 )
+        return 0.0f;
+
+    return static_cast<float>( getGlyphArea() ) / static_cast<float>( imageArea );
+}
+
+void GlyphAtlas::pack()
+{
+    // Estimate the area of the glyphs (in the same way as stbtt_PackFontRanges) to choose the width of the image.
+    size_t area = 0;
+    int    maxW = 1;
+    int    maxH = 1;
+    for ( const Range& range: ranges )
+    {
+        if ( range.distanceField )
+            continue;
+
+        const float scale = stbtt_ScaleForPixelHeight( &fontInfo, range.size );
+        for ( uint32_t c = range.firstChar; c < range.firstChar + range.numChars; ++c )
+        {
+            int x0, y0, x1, y1;
+            stbtt_GetCodepointBitmapBox( &fontInfo, static_cast<int>( c ), scale * static_cast<float>( range.oversampling ), scale, &x0, &y0, &x1, &y1 );
+
+            const int w = x1 - x0 + static_cast<int>( range.oversampling ) - 1 + Padding;
+            const int h = y1 - y0 + Padding;
+
+            area += static_cast<size_t>( std::max( w, 0 ) ) * std::max( h, 0 );
+            maxW = std::max( maxW, w );
+            maxH = std::max( maxH, h );
+        }
+    }
+
+    // The glyphs are placed on shelves (rows), so larger sizes are packed first to keep the shelves of similar heights together.
+    // Ranges with the same oversampling are packed in a single call.
+    std::vector<size_t> order( ranges.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::erase_if( order, [&]( size_t i ) { return ranges[i].distanceField; } );
+
+    if ( order.empty() )
+        return;
+
+    std::stable_sort( order.begin(), order.end(), [&]( size_t a, size_t b ) {
+        if ( ranges[a].oversampling != ranges[b].oversampling )
+            return ranges[a].oversampling < ranges[b].oversampling;
+        return ranges[a].size > ranges[b].size;
+    } );
+
+    std::vector<stbtt_pack_range> packRanges;
+    packRanges.reserve( ranges.size() );
+    for ( const size_t i: order )
+    {
+        Range&           range = ranges[i];
+        stbtt_pack_range packRange {};
+        packRange.font_size                        = range.size;
+        packRange.first_unicode_codepoint_in_range = static_cast<int>( range.firstChar );
+        packRange.num_chars                        = static_cast<int>( range.numChars );
+        packRange.chardata_for_range               = range.chars.data();
+        packRanges.push_back( packRange );
+    }
+
+    const int width  = std::max( maxW, static_cast<int>( std::ceil( std::sqrt( static_cast<double>( area ) ) ) ) );
+    int       height = static_cast<int>( 2 * area / width ) + maxH;
+
+    std::vector<unsigned char> pixels;
+    for ( ;; )
+    {
+        pixels.assign( static_cast<size_t>( width ) * height, 0 );
+
+        stbtt_pack_context context;
+        if ( !stbtt_PackBegin( &context, pixels.data(), width, height, 0, Padding, nullptr ) )
+            return;
+
+        bool packed = true;
+        for ( size_t i = 0; i < packRanges.size(); )
+        {
+            // Find the ranges with the same oversampling.
+            const uint32_t oversampling = ranges[order[i]].oversampling;
+            size_t         j            = i + 1;
+            while ( j < packRanges.size() && ranges[order[j]].oversampling == oversampling )
+                ++j;
+
+            stbtt_PackSetOversampling( &context, oversampling, 1 );
+            packed = stbtt_PackFontRanges( &context, fontData.data(), 0, packRanges.data() + i, static_cast<int>( j - i ) ) && packed;
+
+            i = j;
+        }
+
+        stbtt_PackEnd( &context );
+
+        if ( packed )
+            break;
+
+        // Try again with a taller image if not all glyphs fit.
+        if ( height >= MaxHeight )
+        {
+            std::cerr << "Not all glyphs fit in the glyph atlas." << std::endl;
+            break;
+        }
+
+        height = std::min( height * 2, MaxHeight );
+    }
+
+    // Crop the image to the area that is covered by the glyphs.
+    int usedW = 1;
+    int usedH = 1;
+    for ( const Range& range: ranges )
+    {
+        if ( range.distanceField )
+            continue;
+
+        for ( const stbtt_packedchar& c: range.chars )
+        {
+            usedW = std::max( usedW, static_cast<int>( c.x1 ) );
+            usedH = std::max( usedH, static_cast<int>( c.y1 ) );
+        }
+    }
+
+    auto atlas = std::make_shared<AlphaImage>( usedW, usedH );
+    for ( int y = 0; y < usedH; ++y )
+        std::memcpy( atlas->data() + static_cast<size_t>( y ) * usedW, pixels.data() + static_cast<size_t>( y ) * width, usedW );
+
+    image = std::move( atlas );
+}
+
+void GlyphAtlas::packDistanceField( Range& range )
+{
+    const float scale = stbtt_ScaleForPixelHeight( &fontInfo, DistanceFieldSize );
+
+    // The glyphs that are copied to the new image: either from the previous image or from a new distance field.
+    struct Glyph
+    {
+        stbtt_packedchar*    c;
+        const unsigned char* pixels;
+        int                  stride;
+        int                  w, h;
+    };
+
+    std::vector<Glyph>                                        glyphs;
+    std::vector<std::unique_ptr<unsigned char[], SDFDeleter>> fields;
+
+    for ( Range& r: ranges )
+    {
+        if ( !r.distanceField || &r == &range || !distanceFieldImage )
+            continue;
+
+        for ( stbtt_packedchar& c: r.chars )
+        {
+            const int stride = static_cast<int>( distanceFieldImage->getWidth() );
+            glyphs.push_back( { &c, distanceFieldImage->data() + static_cast<size_t>( c.y0 ) * stride + c.x0, stride, c.x1 - c.x0, c.y1 - c.y0 } );
+        }
+    }
+
+    for ( uint32_t i = 0; i < range.numChars; ++i )
+    {
+        const int codepoint = static_cast<int>( range.firstChar + i );
+
+        int advance, lsb;
+        stbtt_GetCodepointHMetrics( &fontInfo, codepoint, &advance, &lsb );
+
+        // Glyphs without an outline (like the space character) don't have a distance field.
+        int            w = 0, h = 0, xoff = 0, yoff = 0;
+        unsigned char* sdf = stbtt_GetCodepointSDF( &fontInfo, scale, codepoint, DistanceFieldPadding, DistanceFieldEdge, DistanceFieldScale, &w, &h, &xoff, &yoff );
+        if ( !sdf )
+            w = h = 0;
+
+        stbtt_packedchar& c = range.chars[i];
+        c                   = {};
+        c.xoff              = static_cast<float>( xoff );
+        c.yoff              = static_cast<float>( yoff );
+        c.xoff2             = static_cast<float>( xoff + w );
+        c.yoff2             = static_cast<float>( yoff + h );
+        c.xadvance          = scale * static_cast<float>( advance );
+
+        glyphs.push_back( { &c, sdf, w, w, h } );
+        fields.emplace_back( sdf );
+    }
+
+    // Place the glyphs on shelves, tallest glyphs first.
+    size_t area = 0;
+    int    maxW = 1;
+    for ( const Glyph& g: glyphs )
+    {
+        area += static_cast<size_t>( g.w ) * g.h;
+        maxW = std::max( maxW, g.w );
+    }
+
+    std::stable_sort( glyphs.begin(), glyphs.end(), []( const Glyph& a, const Glyph& b ) { return a.h > b.h; } );
+
+    const int width  = std::max( maxW, static_cast<int>( std::ceil( std::sqrt( static_cast<double>( area ) ) ) ) );
+    int       x      = 0;
+    int       y      = 0;
+    int       shelfH = 0;
+    for ( const Glyph& g: glyphs )
+    {
+        if ( g.w == 0 || g.h == 0 )
+        {
+            g.c->x0 = g.c->y0 = g.c->x1 = g.c->y1 = 0;
+            continue;
+        }
+
+        if ( x + g.w > width )
+        {
+            x = 0;
+            y += shelfH;
+            shelfH = 0;
+        }
+
+        g.c->x0 = static_cast<unsigned short>( x );
+        g.c->y0 = static_cast<unsigned short>( y );
+        g.c->x1 = static_cast<unsigned short>( x + g.w );
+        g.c->y1 = static_cast<unsigned short>( y + g.h );
+
+        x += g.w;
+        shelfH = std::max( shelfH, g.h );
+    }
+
+    auto atlas = std::make_shared<AlphaImage>( width, std::max( y + shelfH, 1 ) );
+    atlas->clear();
+
+    for ( const Glyph& g: glyphs )
+    {
+        for ( int j = 0; j < g.h; ++j )
+            std::memcpy( &( *atlas )( g.c->x0, g.c->y0 + j ), g.pixels + static_cast<size_t>( j ) * g.stride, g.w );
+    }
+
+    distanceFieldImage = std::move( atlas );
+}
@@ -1,8 +1,16 @@
+#include <Graphics/AlphaImage.hpp>
 #include <Graphics/Font.hpp>
 #include <Graphics/Image.hpp>
+#include <Graphics/RasterState.hpp>
+#include <Graphics/SDFStyle.hpp>
 #include <Graphics/Sprite.hpp>
 #include <Graphics/Vertex.hpp>
 
+#include "MappedFile.hpp"
+#include "PixelFormat.hpp"
+#include "Rasterizer.hpp"
+#include "TiledRenderer.hpp"
+
 #include <Math/AABB.hpp>
 #include <Math/Math.hpp>
 
@@ -10,17 +18,57 @@
 #include <stb_image_write.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-#include <numbers>
 #include <optional>
+#include <vector>
 
 using namespace Graphics;
 using namespace Math;
 
+// The number of pixels that are gathered into a buffer on the stack before they are blended into the image.
+constexpr int SpanBufferSize = 256;
+
+// The header of a cooked image. The pixels of the image follow the header.
+// The header is 64 bytes so that the pixels are aligned to a cache line in the (page aligned) mapped file.
+struct CookedHeader
+{
+    static constexpr uint32_t Magic   = 0x58545253u;  // "SRTX"
+    static constexpr uint32_t Version = 1u;
+
+    // Flags.
+    static constexpr uint32_t Premultiplied = 1u << 0;
+
+    uint32_t magic   = Magic;
+    uint32_t version = Version;
+    uint32_t width   = 0u;
+    uint32_t height  = 0u;
+    uint32_t flags   = 0u;
+    uint32_t reserved[11] {};
+};
+
+static_assert( sizeof( CookedHeader ) == 64 );
+
 Image::Image() = default;
 
+uint64_t Image::nextGeneration() noexcept
+{
+    // Generations are unique across all images, so an image that is allocated at the address of
+    // a deleted image doesn't have the generation that was recorded for the deleted image.
+    static std::atomic<uint64_t> generation { 0u };
+    return generation.fetch_add( 1u, std::memory_order_relaxed ) + 1u;
+}
+
 Image::Image( const std::filesystem::path& fileName )
 {
+    if ( fileName.extension() == CookedExtension )
+    {
+        loadCooked( fileName );
+        return;
+    }
+
     int            x, y, n;
     unsigned char* data = stbi_load( fileName.string().c_str(), &x, &y, &n, STBI_rgb_alpha );
     if ( !data )
@@ -29,24 +77,16 @@ Image::Image( const std::filesystem::path& fileName )
         return;
     }
 
-    // Convert ARGB
-    unsigned char* p = data;
-    for ( size_t i = 0; i < x * y; ++i )
-    {
-        unsigned char c = p[0];
-        p[0]            = p[2];
-        p[2]            = c;
-        p += 4;
-    }
-
     resize( static_cast<uint32_t>( x ), static_cast<uint32_t>( y ) );
 
-    memcpy_s( m_data.get(), static_cast<rsize_t>( m_width ) * m_height * sizeof( Color ), data, static_cast<rsize_t>( m_width ) * m_height * sizeof( Color ) );
+    // Convert RGBA to ARGB.
+    PixelFormat::fromRGBA( m_data.get(), data, static_cast<size_t>( m_width ) * m_height );
 
     stbi_image_free( data );
 }
 
 Image::Image( const Image& copy )
+: m_premultiplied { copy.m_premultiplied }
 {
     resize( copy.m_width, copy.m_height );
     memcpy_s( data(), static_cast<rsize_t>( m_width ) * m_height * sizeof( Color ), copy.data(), static_cast<rsize_t>( copy.m_width ) * copy.m_height * sizeof( Color ) );
@@ -57,9 +97,14 @@ Image::Image( Image&& move ) noexcept
 , m_height { move.m_height }
 , m_AABB { move.m_AABB }
 , m_data { std::move( move.m_data ) }
+, m_premultiplied { move.m_premultiplied }
+, m_deferred { move.m_deferred }
+, m_tiledRenderer { std::move( move.m_tiledRenderer ) }
 {
-    move.m_width  = 0u;
-    move.m_height = 0u;
+    move.m_width      = 0u;
+    move.m_height     = 0u;
+    move.m_deferred   = false;
+    move.m_generation = nextGeneration();
 }
 
 Image::Image( uint32_t width, uint32_t height )
@@ -67,11 +112,16 @@ Image::Image( uint32_t width, uint32_t height )
     resize( width, height );
 }
 
+Image::~Image() = default;
+
 Image& Image::operator=( const Image& image )
 {
     resize( image.m_width, image.m_height );
     memcpy_s( data(), static_cast<rsize_t>( m_width ) * m_height * sizeof( Color ), image.data(), static_cast<rsize_t>( image.m_width ) * image.m_height * sizeof( Color ) );
 
+    m_premultiplied = image.m_premultiplied;
+    m_generation    = nextGeneration();
+
     return *this;
 }
 
@@ -81,10 +131,18 @@ Image& Image::operator=( Image&& image ) noexcept
     m_height = image.m_height;
     m_AABB   = image.m_AABB;
 
-    m_data = std::move( image.m_data );
+    m_data          = std::move( image.m_data );
+    m_premultiplied = image.m_premultiplied;
+
+    m_deferred      = image.m_deferred;
+    m_tiledRenderer = std::move( image.m_tiledRenderer );
 
-    image.m_width  = 0u;
-    image.m_height = 0u;
+    m_generation = nextGeneration();
+
+    image.m_width      = 0u;
+    image.m_height     = 0u;
+    image.m_deferred   = false;
+    image.m_generation = nextGeneration();
 
     return *this;
 }
@@ -94,9 +152,10 @@ void Image::resize( uint32_t width, uint32_t height )
     if ( m_width == width && m_height == height )
         return;
 
-    m_width  = width;
-    m_height = height;
-    m_AABB   = {
+    m_width      = width;
+    m_height     = height;
+    m_generation = nextGeneration();
+    m_AABB       = {
         { 0, 0, 0 },
         { m_width - 1, m_height - 1, 0 }
     };
@@ -105,39 +164,165 @@ void Image::resize( uint32_t width, uint32_t height )
     m_data = make_aligned_unique<Color[], 64>( static_cast<uint64_t>( width ) * height );
 }
 
+void Image::premultiplyAlpha() noexcept
+{
+    if ( m_premultiplied )
+        return;
+
+    m_generation = nextGeneration();
+
+    // Use the same rounding as BlendMode::AlphaBlend so that blending the premultiplied
+    // image with BlendMode::PremultipliedAlpha gives exactly the same result.
+#pragma omp parallel for
+    for ( int y = 0; y < static_cast<int>( m_height ); ++y )
+    {
+        Color* row = m_data.get() + static_cast<size_t>( y ) * m_width;
+        PixelFormat::premultiply( row, row, m_width );
+    }
+
+    m_premultiplied = true;
+}
+
+void Image::loadCooked( const std::filesystem::path& fileName )
+{
+    const MappedFile file { fileName };
+    const auto       data = file.data();
+
+    CookedHeader header;
+    if ( data.size() >= sizeof( header ) )
+        std::memcpy( &header, data.data(), sizeof( header ) );
+
+    const size_t numPixels = static_cast<size_t>( header.width ) * header.height;
+
+    if ( data.size() < sizeof( header ) || header.magic != CookedHeader::Magic || header.version != CookedHeader::Version || data.size() - sizeof( header ) < numPixels * sizeof( Color ) )
+    {
+        std::cerr << "ERROR: Could not load: " << fileName.string() << std::endl;
+        return;
+    }
+
+    resize( header.width, header.height );
+
+    // The pixels are already in the layout of the image: copy them from the mapped file.
+    std::memcpy( m_data.get(), data.data() + sizeof( header ), numPixels * sizeof( Color ) );
+    m_premultiplied = ( header.flags & CookedHeader::Premultiplied ) != 0;
+}
+
+void Image::saveCooked( const std::filesystem::path& fileName ) const
+{
+    CookedHeader header;
+    header.width  = m_width;
+    header.height = m_height;
+    header.flags  = m_premultiplied ? CookedHeader::Premultiplied : 0u;
+
+    std::ofstream output { fileName, std::ios::out | std::ios::binary };
+    output.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    output.write( reinterpret_cast<const char*>( m_data.get() ), static_cast<std::streamsize>( static_cast<size_t>( m_width ) * m_height * sizeof( Color ) ) );
+
+    if ( !output )
+        std::cerr << "ERROR: Could not save: " << fileName.string() << std::endl;
+}
+
 void Image::save( const std::filesystem::path& file ) const
 {
     const auto extension = file.extension();
 
+    if ( extension == CookedExtension )
+    {
+        saveCooked( file );
+        return;
+    }
+
+    if ( extension != ".png" && extension != ".bmp" && extension != ".tga" && extension != ".jpg" )
+    {
+        std::cerr << "Invalid file type: " << file << std::endl;
+        return;
+    }
+
+    // Convert the pixels to (straight alpha) RGBA, which is expected by stb_image_write.
+    const size_t       numPixels = static_cast<size_t>( m_width ) * m_height;
+    std::vector<Color> pixels( numPixels );
+    const auto         rgba = reinterpret_cast<uint8_t*>( pixels.data() );
+
+    PixelFormat::toRGBA( rgba, m_data.get(), numPixels );
+
+    // Unpremultiplying doesn't depend on the order of the color channels.
+    if ( m_premultiplied )
+        PixelFormat::unpremultiply( pixels.data(), pixels.data(), numPixels );
+
     if ( extension == ".png" )
     {
-        stbi_write_png( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, m_data.get(), static_cast<int>( m_width * sizeof( Color ) ) );
+        stbi_write_png( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, rgba, static_cast<int>( m_width * sizeof( Color ) ) );
     }
     else if ( extension == ".bmp" )
     {
-        stbi_write_bmp( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, m_data.get() );
+        stbi_write_bmp( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, rgba );
     }
     else if ( extension == ".tga" )
     {
-        stbi_write_tga( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, m_data.get() );
+        stbi_write_tga( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, rgba );
     }
     else if ( extension == ".jpg" )
     {
-        stbi_write_jpg( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, m_data.get(), 10 );
+        stbi_write_jpg( file.string().c_str(), static_cast<int>( m_width ), static_cast<int>( m_height ), 4, rgba, 10 );
     }
-    else
+}
+
+void Image::clear( const Color& color ) noexcept
+{
+    if ( !m_data )
+        return;
+
+    m_generation = nextGeneration();
+
+    if ( m_deferred )
     {
-        std::cerr << "Invalid file type: " << file << std::endl;
+        m_tiledRenderer->record( TiledRenderer::ClearCommand { color } );
+        return;
     }
+
+    rasterClear( color, m_AABB );
 }
 
-void Image::clear( const Color& color ) noexcept
+void Image::beginDeferred()
 {
-    Color* p = data();
+    if ( !m_tiledRenderer )
+        m_tiledRenderer = std::make_unique<TiledRenderer>();
 
-#pragma omp parallel for
-    for ( int i = 0; i < static_cast<int>( m_width * m_height ); ++i )
-        p[i] = color;
+    m_deferred = true;
+}
+
+void Image::setDirtyTracking( bool enable )
+{
+    if ( !m_tiledRenderer )
+        m_tiledRenderer = std::make_unique<TiledRenderer>();
+
+    m_tiledRenderer->setDirtyTracking( enable );
+}
+
+bool Image::isDirtyTracking() const noexcept
+{
+    return m_tiledRenderer && m_tiledRenderer->isDirtyTracking();
+}
+
+void Image::invalidate() noexcept
+{
+    if ( m_tiledRenderer )
+        m_tiledRenderer->invalidate();
+}
+
+void Image::endDeferred()
+{
+    flush();
+    m_deferred = false;
+}
+
+void Image::flush()
+{
+    if ( m_deferred )
+    {
+        m_generation = nextGeneration();
+        m_tiledRenderer->flush( *this );
+    }
 }
 
 void Image::copy( const Image& srcImage, std::optional<Math::RectI> srcRect, std::optional<Math::RectI> dstRect, const BlendMode& blendMode )
@@ -157,159 +342,78 @@ void Image::copy( const Image& srcImage, std::optional<Math::RectI> srcRect, std
     // Clamp the source AABB to the AABB of the source image (to prevent sampling outside of the source image bounds).
     srcAABB.clamp( srcImage.m_AABB );
 
-    // Source width
-    const int sW = static_cast<int>( srcAABB.width() );
-    // Source height
-    const int sH = static_cast<int>( srcAABB.height() );
-
     // If the destination AABB doesn't intersect with this image bounds...
     // In other words, the destination bounds is completely offscreen.
     if ( !m_AABB.intersect( dstAABB ) )
         return;
 
-    // Destination width
-    const int dW = static_cast<int>( dstAABB.width() );
-    // Destination height
-    const int dH = static_cast<int>( dstAABB.height() );
-
-    // Clamp the dstAABB to the bounds of this image (to prevent writing outside of this image's bounds).
-    AABB dstImage = dstAABB.clamped( m_AABB );
-
-    // Clamped image width.
-    const int iW = static_cast<int>( dstImage.width() );
-    // Clamped image height.
-    const int iH = static_cast<int>( dstImage.height() );
-    // Clamped image area
-    const int iA = iW * iH;
-
-    // Pointer to source image data.
-    const Color* src = srcImage.data();
-    // Pointer to destination image data.
-    Color* dst = data();
+    m_generation = nextGeneration();
 
-#pragma omp parallel for firstprivate( srcAABB, dstAABB, dstImage, sW, sH, dW, dH, iW, iH )
-    for ( int i = 0; i < iA; ++i )
+    if ( m_deferred )
     {
-        const int x  = i % iW;
-        const int y  = i / iW;
-        const int dx = x + static_cast<int>( dstImage.min.x );
-        const int dy = y + static_cast<int>( dstImage.min.y );
-        const int sx = ( x * sW / dW ) + static_cast<int>( srcAABB.min.x );
-        const int sy = ( y * sH / dH ) + static_cast<int>( srcAABB.min.y );
-
-        const Color sC = src[sy * srcImage.getWidth() + sx];
-        const Color dC = dst[dy * m_width + dx];
-
-        dst[dy * m_width + dx] = blendMode.Blend( sC, dC );
+        m_tiledRenderer->record( TiledRenderer::ScaledCopyCommand { &srcImage, srcImage.getGeneration(), srcAABB, dstAABB, blendMode } );
+        return;
     }
+
+    rasterCopy( srcImage, srcAABB, dstAABB, blendMode, m_AABB );
 }
 
 void Image::copy( const Image& srcImage, int x, int y )
 {
-    // Source image coords.
-    const int sX = x < 0 ? -x : 0;
-    const int sY = y < 0 ? -y : 0;
-    const int sW = static_cast<int>( srcImage.getWidth() ) - sX;
-    const int sH = static_cast<int>( srcImage.getHeight() ) - sY;
+    m_generation = nextGeneration();
 
-    // Check if source image is offscreen.
-    if ( sW <= 0 || sH <= 0 )
-        return;
-
-    // Destination coords.
-    const int dX = x < 0 ? 0 : x;
-    const int dY = y < 0 ? 0 : y;
-    const int dW = static_cast<int>( m_width ) - dX;
-    const int dH = static_cast<int>( m_height ) - dY;
-
-    // Check if the destination range is offscreen.
-    if ( dW <= 0 || dH <= 0 )
+    if ( m_deferred )
+    {
+        m_tiledRenderer->record( TiledRenderer::CopyCommand { &srcImage, srcImage.getGeneration(), x, y } );
         return;
+    }
 
-    // The destination copy region is the minimum of the source
-    // and destination dimensions.
-    const int w = std::min( sW, dW );
-    const int h = std::min( sH, dH );
-
-    const uint32_t srcWidth = srcImage.getWidth();
-    const Color*   src      = srcImage.data();
-    Color*         dst      = data();
-
-#pragma omp parallel for firstprivate( w, h, sX, sY, dX, dY )
-    for ( int i = 0; i < h; ++i )
-        memcpy_s( dst + ( i + dY ) * m_width + dX, w * sizeof( Color ), src + ( i + sY ) * srcWidth + sX, w * sizeof( Color ) );
+    rasterCopy( srcImage, x, y, m_AABB );
 }
 
-// Source: https://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
 void Image::drawLine( int x0, int y0, int x1, int y1, const Color& color, const BlendMode& blendMode ) noexcept
 {
-    // Shrink the image AABB by 1 pixel to prevent drawing the line outside of the image bounds.
-    if ( !m_AABB.clip( x0, y0, x1, y1 ) )
-        return;
-
-    const int dx = std::abs( x1 - x0 );
-    const int dy = -std::abs( y1 - y0 );
-    const int sx = x0 < x1 ? 1 : -1;
-    const int sy = y0 < y1 ? 1 : -1;
-
-    int err = dx + dy;
+    m_generation = nextGeneration();
 
-    while ( true )
+    if ( m_deferred )
     {
-        plot<false>( x0, y0, color, blendMode );
-        const int e2 = err * 2;
-
-        if ( e2 >= dy )
-        {
-            if ( x0 == x1 )
-                break;
-
-            err += dy;
-            x0 += sx;
-        }
-        if ( e2 <= dx )
-        {
-            if ( y0 == y1 )
-                break;
-
-            err += dx;
-            y0 += sy;
-        }
+        m_tiledRenderer->record( TiledRenderer::LineCommand { x0, y0, x1, y1, color, blendMode } );
+        return;
     }
+
+    rasterLine( x0, y0, x1, y1, color, blendMode, m_AABB );
 }
 
 void Image::drawTriangle( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const Color& color, const BlendMode& blendMode, FillMode fillMode ) noexcept
 {
     // Create an AABB for the triangle.
-    AABB aabb = AABB::fromTriangle( { p0, 0 }, { p1, 0 }, { p2, 0 } );
+    const AABB aabb = AABB::fromTriangle( { p0, 0 }, { p1, 0 }, { p2, 0 } );
 
     // Check if the triangle is on screen.
     if ( !m_AABB.intersect( aabb ) )
         return;
 
+    m_generation = nextGeneration();
+
     switch ( fillMode )
     {
     case FillMode::WireFrame:
     {
-        drawLine( p0, p1, color, blendMode );
-        drawLine( p1, p2, color, blendMode );
-        drawLine( p2, p0, color, blendMode );
+        const glm::ivec2  i0 { p0 }, i1 { p1 }, i2 { p2 };
+        const LineSegment lines[] = {
+            { i0, i1 },
+            { i1, i2 },
+            { i2, i0 },
+        };
+        drawLines( lines, color, blendMode );
     }
     break;
     case FillMode::Solid:
     {
-        // Clamp the triangle AABB to the screen bounds.
-        aabb.clamp( m_AABB );
-
-#pragma omp parallel for schedule( dynamic ) firstprivate( aabb )
-        for ( int y = static_cast<int>( aabb.min.y ); y <= static_cast<int>( aabb.max.y ); ++y )
-        {
-            for ( int x = static_cast<int>( aabb.min.x ); x <= static_cast<int>( aabb.max.x ); ++x )
-            {
-                if ( pointInsideTriangle( { x, y }, p0, p1, p2 ) )
-                    plot<false>( x, y, color, blendMode );
-            }
-        }
+        if ( m_deferred )
+            m_tiledRenderer->record( TiledRenderer::TriangleCommand { p0, p1, p2, color, blendMode } );
+        else
+            rasterTriangle( p0, p1, p2, color, blendMode, m_AABB );
     }
     break;
     }
@@ -317,65 +421,43 @@ void Image::drawTriangle( const glm::vec2& p0, const glm::vec2& p1, const glm::v
 
 void Image::drawQuad( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const Color& color, const BlendMode& blendMode, FillMode fillMode ) noexcept
 {
-    AABB aabb = AABB::fromQuad( { p0, 0 }, { p1, 0 }, { p2, 0 }, { p3, 0 } );
+    const AABB aabb = AABB::fromQuad( { p0, 0 }, { p1, 0 }, { p2, 0 }, { p3, 0 } );
 
     // Check if the triangle is on screen.
     if ( !m_AABB.intersect( aabb ) )
         return;
 
+    m_generation = nextGeneration();
+
     switch ( fillMode )
     {
     case FillMode::WireFrame:
     {
-        drawLine( p0, p1, color, blendMode );
-        drawLine( p1, p2, color, blendMode );
-        drawLine( p2, p3, color, blendMode );
-        drawLine( p3, p0, color, blendMode );
+        const glm::ivec2  i0 { p0 }, i1 { p1 }, i2 { p2 }, i3 { p3 };
+        const LineSegment lines[] = {
+            { i0, i1 },
+            { i1, i2 },
+            { i2, i3 },
+            { i3, i0 },
+        };
+        drawLines( lines, color, blendMode );
     }
     break;
     case FillMode::Solid:
     {
-        glm::vec2 verts[] = {
-            p0, p1, p2, p3
-        };
-
-        // Index buffer for the two triangles of the quad.
-        const uint32_t indicies[] = {
-            0, 1, 3,
-            1, 2, 3
-        };
-
-        // Clamp to the size of the screen.
-        aabb.clamp( m_AABB );
-
-#pragma omp parallel for schedule( dynamic ) firstprivate( aabb, indicies, verts )
-        for ( int y = static_cast<int>( aabb.min.y ); y <= static_cast<int>( aabb.max.y ); ++y )
-        {
-            for ( int x = static_cast<int>( aabb.min.x ); x <= static_cast<int>( aabb.max.x ); ++x )
-            {
-                for ( uint32_t i = 0; i < std::size( indicies ); i += 3 )
-                {
-                    const uint32_t i0 = indicies[i + 0];
-                    const uint32_t i1 = indicies[i + 1];
-                    const uint32_t i2 = indicies[i + 2];
-
-                    glm::vec3 bc = barycentric( verts[i0], verts[i1], verts[i2], { x, y } );
-                    if ( barycentricInside( bc ) )
-                    {
-                        plot<false>( static_cast<uint32_t>( x ), static_cast<uint32_t>( y ), color, blendMode );
-                    }
-                }
-            }
-        }
+        if ( m_deferred )
+            m_tiledRenderer->record( TiledRenderer::QuadCommand { p0, p1, p2, p3, color, blendMode } );
+        else
+            rasterQuad( p0, p1, p2, p3, color, blendMode, m_AABB );
     }
     break;
     }
 }
 
-void Image::drawQuad( const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vertex& v3, const Image& image, AddressMode addressMode, const BlendMode& _blendMode ) noexcept
+void Image::drawQuad( const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vertex& v3, const Image& image, AddressMode addressMode, const BlendMode& blendMode ) noexcept
 {
     // Compute an AABB over the sprite quad.
-    AABB aabb {
+    const AABB aabb {
         { v0.position, 0.0f },
         { v1.position, 0.0f },
         { v2.position, 0.0f },
@@ -386,46 +468,15 @@ void Image::drawQuad( const Vertex& v0, const Vertex& v1, const Vertex& v2, cons
     if ( !m_AABB.intersect( aabb ) )
         return;
 
-    // Clamp to the size of the screen.
-    aabb.clamp( m_AABB );
-
-    Vertex verts[] = {
-        v0, v1, v2, v3
-    };
-
-    // Index buffer for the two triangles of the quad.
-    const uint32_t indicies[] = {
-        0, 1, 3,
-        1, 2, 3
-    };
-
-    const BlendMode blendMode = _blendMode;
+    m_generation = nextGeneration();
 
-#pragma omp parallel for schedule( dynamic ) firstprivate( aabb, indicies, verts, addressMode, blendMode )
-    for ( int y = static_cast<int>( aabb.min.y ); y <= static_cast<int>( aabb.max.y ); ++y )
+    if ( m_deferred )
     {
-        for ( int x = static_cast<int>( aabb.min.x ); x <= static_cast<int>( aabb.max.x ); ++x )
-        {
-            for ( uint32_t i = 0; i < std::size( indicies ); i += 3 )
-            {
-                const uint32_t i0 = indicies[i + 0];
-                const uint32_t i1 = indicies[i + 1];
-                const uint32_t i2 = indicies[i + 2];
-
-                glm::vec3 bc = barycentric( verts[i0].position, verts[i1].position, verts[i2].position, { x, y } );
-                if ( barycentricInside( bc ) )
-                {
-                    // Compute interpolated UV
-                    const glm::vec2 texCoord = verts[i0].texCoord * bc.x + verts[i1].texCoord * bc.y + verts[i2].texCoord * bc.z;
-                    const Color     color    = verts[i0].color * bc.x + verts[i1].color * bc.y + verts[i2].color * bc.z;
-                    // Sample the texture.
-                    const Color c = image.sample( texCoord.x, texCoord.y, addressMode ) * color;
-                    // Plot.
-                    plot<false>( static_cast<uint32_t>( x ), static_cast<uint32_t>( y ), c, blendMode );
-                }
-            }
-        }
+        m_tiledRenderer->record( TiledRenderer::TexturedQuadCommand { v0, v1, v2, v3, &image, image.getGeneration(), addressMode, blendMode } );
+        return;
     }
+
+    rasterQuad( v0, v1, v2, v3, image, addressMode, blendMode, m_AABB );
 }
 
 void Image::drawAABB( AABB aabb, const Color& color, const BlendMode& blendMode, FillMode fillMode ) noexcept
@@ -433,35 +484,22 @@ void Image::drawAABB( AABB aabb, const Color& color, const BlendMode& blendMode,
     if ( !m_AABB.intersect( aabb ) )
         return;
 
+    m_generation = nextGeneration();
+
+    if ( m_deferred )
+    {
+        m_tiledRenderer->record( TiledRenderer::AABBCommand { aabb, color, blendMode, fillMode } );
+        return;
+    }
+
     switch ( fillMode )
     {
     case FillMode::WireFrame:
-    {
-        const glm::ivec2 min     = aabb.min;
-        const glm::ivec2 max     = aabb.max;
-        const glm::ivec2 verts[] = { { min.x, min.y }, { max.x, min.y }, { max.x, max.y }, { min.x, max.y } };
-
-        for ( int i = 0; i < 4; ++i )
-        {
-            drawLine( verts[i], verts[( i + 1 ) % 4], color, blendMode );
-        }
-    }
-    break;
+        rasterAABBOutline( aabb, color, blendMode, m_AABB );
+        break;
     case FillMode::Solid:
-    {
-        // Clamp to screen bounds.
-        aabb.clamp( m_AABB );
-
-#pragma omp parallel for schedule( dynamic ) firstprivate( aabb )
-        for ( int y = static_cast<int>( aabb.min.y ); y <= static_cast<int>( aabb.max.y ); ++y )
-        {
-            for ( int x = static_cast<int>( aabb.min.x ); x <= static_cast<int>( aabb.max.x ); ++x )
-            {
-                plot<false>( x, y, color, blendMode );
-            }
-        }
-    }
-    break;
+        rasterAABB( aabb, color, blendMode, m_AABB );
+        break;
     }
 }
 
@@ -470,167 +508,959 @@ void Image::drawCircle( const Math::Circle& c, const Color& color, const BlendMo
     if ( !m_AABB.intersect( c ) )
         return;
 
-    for ( int i = 0; i < 64; ++i )
-    {
-        const float a1 = static_cast<float>( i ) * std::numbers::pi_v<float> / 32.0f;
-        const float a2 = static_cast<float>( i + 1 ) * std::numbers::pi_v<float> / 32.0f;
-
-        const glm::vec2 p0 { c.center.x + std::cos( a1 ) * c.radius, c.center.y + std::sin( a1 ) * c.radius };
-        const glm::vec2 p1 { c.center.x + std::cos( a2 ) * c.radius, c.center.y + std::sin( a2 ) * c.radius };
-
-        switch ( fillMode )
-        {
-        case FillMode::WireFrame:
-            drawLine( p0, p1, color, blendMode );
-            break;
-        case FillMode::Solid:
-            drawTriangle( p0, p1, c.center, color, blendMode, fillMode );
-            break;
-        }
-    }
+    drawEllipse( c.center, glm::vec2 { c.radius }, color, blendMode, fillMode );
 }
 
-void Image::drawSprite( const Sprite& sprite, const glm::mat3& matrix, std::optional<Color> _color) noexcept
+void Image::drawEllipse( const glm::vec2& center, const glm::vec2& radii, const Color& color, const BlendMode& blendMode, FillMode fillMode ) noexcept
 {
-    std::shared_ptr<Image> image = sprite.getImage();
-    if ( !image )
+    if ( !m_AABB.intersect( AABB::fromMinMax( { center - radii, 0 }, { center + radii, 0 } ) ) )
         return;
 
-    const Color       color     = _color ? *_color : sprite.getColor();
-    const BlendMode   blendMode = sprite.getBlendMode();
-    const glm::ivec2& uv        = sprite.getUV();
-    const glm::ivec2& size      = sprite.getSize();
+    const float thickness = fillMode == FillMode::WireFrame ? 1.0f : 0.0f;
 
-    Vertex verts[] = {
-        Vertex { { 0, 0 }, { uv.x, uv.y }, color },                                              // Top-left
-        Vertex { { size.x - 1, 0 }, { uv.x + size.x - 1, uv.y }, color },                        // Top-right
-        Vertex { { size.x - 1, size.y - 1 }, { uv.x + size.x - 1, uv.y + size.y - 1 }, color },  // Bottom-right
-        Vertex { { 0, size.y - 1 }, { uv.x, uv.y + size.y - 1 }, color }                         // Bottom-left
-    };
+    m_generation = nextGeneration();
 
-    // Transform verts.
-    for ( Vertex& v: verts )
+    if ( m_deferred )
     {
-        v.position = matrix * glm::vec3 { v.position, 1.0f };
+        m_tiledRenderer->record( TiledRenderer::EllipseCommand { center, radii, thickness, color, blendMode } );
+        return;
     }
 
-    // Compute an AABB over the sprite quad.
-    AABB aabb {
-        { verts[0].position, 0.0f },
-        { verts[1].position, 0.0f },
-        { verts[2].position, 0.0f },
-        { verts[3].position, 0.0f }
-    };
+    rasterEllipse( center, radii, thickness, color, blendMode, m_AABB );
+}
 
-    // Check if the AABB of the sprite is on screen.
-    if ( !m_AABB.intersect( aabb ) )
+void Image::drawSprite( const Sprite& sprite, const glm::mat3& matrix, std::optional<Color> _color ) noexcept
+{
+    // Fully transparent sprites are trimmed to an empty rectangle.
+    if ( !sprite.getImage() || sprite.getTrimRect().width <= 0 || sprite.getTrimRect().height <= 0 )
         return;
 
-    // Clamp to the size of the screen.
-    aabb.clamp( m_AABB );
+    const Color color = _color ? *_color : sprite.getColor();
 
-    // Index buffer for the two triangles of the quad.
-    const uint32_t indicies[] = {
-        0, 1, 3,
-        1, 2, 3
-    };
+    m_generation = nextGeneration();
 
-#pragma omp parallel for schedule( dynamic ) firstprivate( aabb, indicies, verts, color, blendMode )
-    for ( int y = static_cast<int>( aabb.min.y ); y <= static_cast<int>( aabb.max.y ); ++y )
+    if ( m_deferred )
     {
-        for ( int x = static_cast<int>( aabb.min.x ); x <= static_cast<int>( aabb.max.x ); ++x )
-        {
-            for ( uint32_t i = 0; i < std::size( indicies ); i += 3 )
-            {
-                const uint32_t i0 = indicies[i + 0];
-                const uint32_t i1 = indicies[i + 1];
-                const uint32_t i2 = indicies[i + 2];
-
-                glm::vec3 bc = barycentric( verts[i0].position, verts[i1].position, verts[i2].position, { x, y } );
-                if ( barycentricInside( bc ) )
-                {
-                    // Compute interpolated UV
-                    const glm::ivec2 texCoord = round( verts[i0].texCoord * bc.x + verts[i1].texCoord * bc.y + verts[i2].texCoord * bc.z );
-                    // Sample the sprite's texture.
-                    const Color c = image->sample( texCoord.x, texCoord.y, AddressMode::Clamp ) * color;
-                    // Plot.
-                    plot<false>( static_cast<uint32_t>( x ), static_cast<uint32_t>( y ), c, blendMode );
-                }
-            }
-        }
+        m_tiledRenderer->record( TiledRenderer::SpriteCommand { sprite, sprite.getImage()->getGeneration(), matrix, color } );
+        return;
     }
+
+    rasterSprite( sprite, matrix, color, m_AABB );
 }
 
 void Image::drawSprite( const Sprite& sprite, int x, int y ) noexcept
 {
-    std::shared_ptr<Image> image = sprite.getImage();
-    if ( !image )
+    // Fully transparent sprites are trimmed to an empty rectangle.
+    if ( !sprite.getImage() || sprite.getTrimRect().width <= 0 || sprite.getTrimRect().height <= 0 )
         return;
 
-    const Color      color     = sprite.getColor();
-    const BlendMode  blendMode = sprite.getBlendMode();
-    const glm::ivec2 uv        = sprite.getUV();
-    const glm::ivec2 size      = sprite.getSize();
-
-    // Source sprite coords
-    const int sX = x < 0 ? -x : 0;
-    const int sY = y < 0 ? -y : 0;
-    const int sW = size.x - sX;
-    const int sH = size.y - sY;
+    m_generation = nextGeneration();
 
-    // Check if the sprite is offscreen.
-    if ( sW <= 0 || sH <= 0 )
+    if ( m_deferred )
+    {
+        m_tiledRenderer->record( TiledRenderer::SpriteBlitCommand { sprite, sprite.getImage()->getGeneration(), x, y } );
         return;
+    }
 
-    // Destination coords.
-    const int dX = x < 0 ? 0 : x;
-    const int dY = y < 0 ? 0 : y;
-    const int dW = static_cast<int>( m_width ) - dX;
-    const int dH = static_cast<int>( m_height ) - dY;
+    rasterSprite( sprite, x, y, m_AABB );
+}
 
-    // Check if the destination region is offscreen.
-    if ( dW <= 0 || dH <= 0 )
-        return;
+void Image::rasterClear( const Color& color, const AABB& clip ) noexcept
+{
+    const int x0 = static_cast<int>( clip.min.x );
+    const int y0 = static_cast<int>( clip.min.y );
+    const int x1 = static_cast<int>( clip.max.x );
+    const int y1 = static_cast<int>( clip.max.y );
+    const int w  = x1 - x0 + 1;
 
-    // Source image width.
-    const int iW = static_cast<int>( image->getWidth() );
+    Color* p = m_data.get();
 
-    // The destination copy region is the minimum of the source
-    // and destination dimensions.
-    const int w = std::min( sW, dW );
-    const int h = std::min( sH, dH );
-    const int a = w * h;
+#pragma omp parallel for if ( !m_deferred )
+    for ( int y = y0; y <= y1; ++y )
+        std::fill_n( p + static_cast<size_t>( y ) * m_width + x0, w, color );
+}
 
-    const Color* src = image->data();
-    Color*       dst = data();
+void Image::rasterCopy( const Image& srcImage, const AABB& srcAABB, const AABB& dstAABB, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    // Source offset
+    const int sX = static_cast<int>( srcAABB.min.x );
+    const int sY = static_cast<int>( srcAABB.min.y );
+    // Source width
+    const int sW = static_cast<int>( srcAABB.width() );
+    // Source height
+    const int sH = static_cast<int>( srcAABB.height() );
 
-#pragma omp parallel for firstprivate( w, h, a, iW, color, blendMode )
-    for ( int i = 0; i < a; ++i )
-    {
-        const int x  = i % w;
-        const int y  = i / w;
-        const int dx = dX + x;
-        const int dy = dY + y;
-        const int sx = ( sX + uv.x ) + x;
-        const int sy = ( sY + uv.y ) + y;
+    // Destination offset
+    const int dX = static_cast<int>( dstAABB.min.x );
+    const int dY = static_cast<int>( dstAABB.min.y );
+    // Destination width
+    const int dW = static_cast<int>( dstAABB.width() );
+    // Destination height
+    const int dH = static_cast<int>( dstAABB.height() );
 
-        Color dC = dst[dy * m_width + dx];
-        Color sC = src[sy * iW + sx] * color;
+    // The destination region clipped to the clip rectangle (to prevent writing outside of this image's bounds).
+    const int x0 = std::max( dX, static_cast<int>( clip.min.x ) );
+    const int y0 = std::max( dY, static_cast<int>( clip.min.y ) );
+    const int x1 = std::min( dX + dW, static_cast<int>( clip.max.x ) + 1 );
+    const int y1 = std::min( dY + dH, static_cast<int>( clip.max.y ) + 1 );
 
-        dst[dy * m_width + dx] = blendMode.Blend( sC, dC );
-    }
-}
+    // Clamped image width.
+    const int iW = x1 - x0;
+    // Clamped image height.
+    const int iH = y1 - y0;
 
-void Image::drawText( const Font& font, std::string_view text, int x, int y, const Color& color ) noexcept
+    if ( iW <= 0 || iH <= 0 )
+        return;
+
+    // Pointer to source image data.
+    const Color* src = srcImage.data();
+    // Pointer to destination image data.
+    Color* dst = m_data.get();
+
+    const size_t srcWidth = srcImage.getWidth();
+
+    dispatchRasterState( blendMode, [&]( auto state ) {
+        using State = decltype( state );
+
+#pragma omp parallel for firstprivate( sX, sY, sW, sH, dX, dY, dW, dH, x0, y1, iW ) if ( !m_deferred )
+        for ( int dy = y0; dy < y1; ++dy )
+        {
+            // Source coordinates are relative to the (unclipped) destination region
+            // so that each tile samples the same source pixels.
+            const int sy = ( ( dy - dY ) * sH / dH ) + sY;
+
+            const Color* s = src + sy * srcWidth;
+            Color*       d = dst + static_cast<size_t>( dy ) * m_width;
+
+            if ( sW == dW )
+            {
+                // The rows are not scaled.
+                State::blend( d + x0, s + sX + ( x0 - dX ), iW, blendMode );
+                continue;
+            }
+
+            if constexpr ( State::blendPreset == BlendPreset::Disable )
+            {
+                // Without blending, the scaled source row is written directly to the image.
+                Rasterizer::scaleRow( d + x0, s + sX, x0 - dX, iW, sW, dW );
+            }
+            else
+            {
+                // Gather the scaled source row and blend it in chunks.
+                Color span[SpanBufferSize];
+                for ( int x = x0; x < x1; x += SpanBufferSize )
+                {
+                    const int n = std::min( x1 - x, SpanBufferSize );
+                    Rasterizer::scaleRow( span, s + sX, x - dX, n, sW, dW );
+
+                    State::blend( d + x, span, n, blendMode );
+                }
+            }
+        }
+    } );
+}
+
+void Image::rasterCopy( const Image& srcImage, int x, int y, const AABB& clip ) noexcept
+{
+    // The destination region clipped to the clip rectangle.
+    const int dX = std::max( x, static_cast<int>( clip.min.x ) );
+    const int dY = std::max( y, static_cast<int>( clip.min.y ) );
+    const int dR = std::min( x + static_cast<int>( srcImage.getWidth() ), static_cast<int>( clip.max.x ) + 1 );
+    const int dB = std::min( y + static_cast<int>( srcImage.getHeight() ), static_cast<int>( clip.max.y ) + 1 );
+
+    // The size of the copy region.
+    const int w = dR - dX;
+    const int h = dB - dY;
+
+    // Check if the source image is outside of the clip rectangle.
+    if ( w <= 0 || h <= 0 )
+        return;
+
+    // Source image coords.
+    const int sX = dX - x;
+    const int sY = dY - y;
+
+    const uint32_t srcWidth = srcImage.getWidth();
+    const Color*   src      = srcImage.data();
+    Color*         dst      = m_data.get();
+
+#pragma omp parallel for firstprivate( w, h, sX, sY, dX, dY ) if ( !m_deferred )
+    for ( int i = 0; i < h; ++i )
+        memcpy_s( dst + ( i + dY ) * m_width + dX, w * sizeof( Color ), src + ( i + sY ) * srcWidth + sX, w * sizeof( Color ) );
+}
+
+// Source: https://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
+void Image::rasterLine( int x0, int y0, int x1, int y1, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    // Clip the line to the image (not the clip rectangle) so that the
+    // same pixels are plotted regardless of the tile that is being rasterized.
+    if ( !m_AABB.clip( x0, y0, x1, y1 ) )
+        return;
+
+    dispatchRasterState( blendMode, [&]( auto state ) {
+        using State = decltype( state );
+
+        rasterLineRuns<State>( x0, y0, x1, y1, color, blendMode, clip );
+    } );
+}
+
+void Image::drawLines( std::span<const LineSegment> lines, const Color& color, const BlendMode& blendMode ) noexcept
+{
+    static_assert( sizeof( LineSegment ) == sizeof( __m128i ), "The coordinates of a line segment must fit in an SSE register." );
+
+    // The bounds of the image for each coordinate of a line (x0, y0, x1, y1).
+    const int     width  = static_cast<int>( m_width ) - 1;
+    const int     height = static_cast<int>( m_height ) - 1;
+    const __m128i min    = _mm_setzero_si128();
+    const __m128i max    = _mm_setr_epi32( width, height, width, height );
+
+    m_generation = nextGeneration();
+
+    if ( m_deferred )
+    {
+        // Only record the lines that are (partially) inside the image. The lines are clipped when the tiles are rasterized.
+        for ( const LineSegment& line: lines )
+        {
+            if ( Rasterizer::classifyLine( _mm_loadu_si128( reinterpret_cast<const __m128i*>( &line ) ), min, max ) != Rasterizer::LineClip::Outside )
+                m_tiledRenderer->record( TiledRenderer::LineCommand { line.p0.x, line.p0.y, line.p1.x, line.p1.y, color, blendMode } );
+        }
+        return;
+    }
+
+    // Select the raster state once for all of the lines.
+    dispatchRasterState( blendMode, [&]( auto state ) {
+        using State = decltype( state );
+
+        for ( const LineSegment& line: lines )
+        {
+            int x0 = line.p0.x;
+            int y0 = line.p0.y;
+            int x1 = line.p1.x;
+            int y1 = line.p1.y;
+
+            // Lines that are completely inside the image don't need to be clipped, and lines that are completely outside are skipped.
+            switch ( Rasterizer::classifyLine( _mm_loadu_si128( reinterpret_cast<const __m128i*>( &line ) ), min, max ) )
+            {
+            case Rasterizer::LineClip::Outside:
+                continue;
+            case Rasterizer::LineClip::Partial:
+                if ( !m_AABB.clip( x0, y0, x1, y1 ) )
+                    continue;
+                break;
+            case Rasterizer::LineClip::Inside:
+                break;
+            }
+
+            rasterLineRuns<State>( x0, y0, x1, y1, color, blendMode, m_AABB );
+        }
+    } );
+}
+
+template<typename State>
+void Image::rasterLineRuns( int x0, int y0, int x1, int y1, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    Rasterizer::line(
+        x0, y0, x1, y1, clip,
+        [&]( int x, int y, int count ) {
+            State::blend( m_data.get() + static_cast<size_t>( y ) * m_width + x, color, count, blendMode );
+        },
+        [&]( int x, int y, int count ) {
+            Color* dst = m_data.get() + static_cast<size_t>( y ) * m_width + x;
+            for ( int i = 0; i < count; ++i, dst += m_width )
+                *dst = blendPixel<State::blendPreset>( color, *dst, blendMode );
+        } );
+}
+
+void Image::rasterTriangle( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    dispatchRasterState( blendMode, [&]( auto state ) {
+        using State = decltype( state );
+
+        Rasterizer::triangle( p0, p1, p2, clip, !m_deferred, [&]( int x, int y, int count ) {
+            State::blend( m_data.get() + static_cast<size_t>( y ) * m_width + x, color, count, blendMode );
+        } );
+    } );
+}
+
+void Image::rasterQuad( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p3, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    // The shared edge of the two triangles is only filled once (top-left fill rule).
+    rasterTriangle( p0, p1, p3, color, blendMode, clip );
+    rasterTriangle( p1, p2, p3, color, blendMode, clip );
+}
+
+void Image::rasterQuad( const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vertex& v3, const Image& image, AddressMode addressMode, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    const Vertex verts[] = {
+        v0, v1, v2, v3
+    };
+
+    // Index buffer for the two triangles of the quad.
+    const uint32_t indicies[] = {
+        0, 1, 3,
+        1, 2, 3
+    };
+
+    // The vertex colors only need to be interpolated if they are not all white.
+    const bool modulate = v0.color != Color::White || v1.color != Color::White || v2.color != Color::White || v3.color != Color::White;
+
+    const glm::vec2 size { image.getWidth(), image.getHeight() };
+
+    dispatchRasterState( blendMode, modulate, addressMode, [&]( auto state ) {
+        using State = decltype( state );
+
+        for ( uint32_t i = 0; i < std::size( indicies ); i += 3 )
+        {
+            const Vertex& t0 = verts[indicies[i + 0]];
+            const Vertex& t1 = verts[indicies[i + 1]];
+            const Vertex& t2 = verts[indicies[i + 2]];
+
+            const Rasterizer::Barycentric barycentric { t0.position, t1.position, t2.position };
+
+            Rasterizer::triangle( t0.position, t1.position, t2.position, clip, !m_deferred, [&]( int x, int y, int count ) {
+                Color span[Rasterizer::BlockSize];
+                for ( int j = 0; j < count; ++j )
+                {
+                    const glm::vec3 bc = barycentric( x + j, y );
+                    // Compute interpolated UV
+                    const glm::ivec2 texCoord = floor( ( t0.texCoord * bc.x + t1.texCoord * bc.y + t2.texCoord * bc.z ) * size );
+                    // Sample the texture.
+                    const Color& texel = State::sample( image, texCoord.x, texCoord.y );
+                    if constexpr ( State::modulate )
+                        span[j] = State::shade( texel, t0.color * bc.x + t1.color * bc.y + t2.color * bc.z );
+                    else
+                        span[j] = texel;
+                }
+                State::blend( m_data.get() + static_cast<size_t>( y ) * m_width + x, span, count, blendMode );
+            } );
+        }
+    } );
+}
+
+void Image::rasterAABB( AABB aabb, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    // Clamp to clip bounds.
+    aabb.clamp( clip );
+
+    const int x  = static_cast<int>( aabb.min.x );
+    const int w  = static_cast<int>( aabb.max.x ) - x + 1;
+    const int y0 = static_cast<int>( aabb.min.y );
+    const int y1 = static_cast<int>( aabb.max.y );
+
+    if ( w <= 0 || y0 > y1 )
+        return;
+
+    dispatchRasterState( blendMode, [&]( auto state ) {
+        using State = decltype( state );
+
+        // Small boxes (like health bars) are filled on the calling thread.
+        if ( !m_deferred && y1 - y0 + 1 >= Rasterizer::MinParallelRows )
+        {
+#pragma omp parallel for schedule( dynamic )
+            for ( int y = y0; y <= y1; ++y )
+                State::blend( m_data.get() + static_cast<size_t>( y ) * m_width + x, color, w, blendMode );
+        }
+        else
+        {
+            for ( int y = y0; y <= y1; ++y )
+                State::blend( m_data.get() + static_cast<size_t>( y ) * m_width + x, color, w, blendMode );
+        }
+    } );
+}
+
+void Image::rasterAABBOutline( const AABB& aabb, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    const int x0 = static_cast<int>( aabb.min.x );
+    const int y0 = static_cast<int>( aabb.min.y );
+    const int x1 = static_cast<int>( aabb.max.x );
+    const int y1 = static_cast<int>( aabb.max.y );
+
+    // Clip the outline.
+    const int minX = std::max( x0, static_cast<int>( clip.min.x ) );
+    const int minY = std::max( y0, static_cast<int>( clip.min.y ) );
+    const int maxX = std::min( x1, static_cast<int>( clip.max.x ) );
+    const int maxY = std::min( y1, static_cast<int>( clip.max.y ) );
+
+    if ( minX > maxX || minY > maxY )
+        return;
+
+    // The top and bottom rows are filled as spans, and the left and right columns between them are plotted,
+    // so each pixel of the outline (including the corners) is only blended once.
+    dispatchRasterState( blendMode, [&]( auto state ) {
+        using State = decltype( state );
+
+        for ( int y = minY; y <= maxY; ++y )
+        {
+            if ( y == y0 || y == y1 )
+            {
+                State::blend( m_data.get() + static_cast<size_t>( y ) * m_width + minX, color, maxX - minX + 1, blendMode );
+            }
+            else
+            {
+                if ( x0 == minX )
+                    State::plot( m_data[static_cast<size_t>( y ) * m_width + x0], color, blendMode );
+                if ( x1 != x0 && x1 == maxX )
+                    State::plot( m_data[static_cast<size_t>( y ) * m_width + x1], color, blendMode );
+            }
+        }
+    } );
+}
+
+void Image::rasterEllipse( const glm::vec2& center, const glm::vec2& radii, float thickness, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    dispatchRasterState( blendMode, [&]( auto state ) {
+        using State = decltype( state );
+
+        Rasterizer::ellipse( center, radii, thickness, clip, !m_deferred, [&]( int x, int y, int count ) {
+            State::blend( m_data.get() + static_cast<size_t>( y ) * m_width + x, color, count, blendMode );
+        } );
+    } );
+}
+
+// Check if a matrix only scales (or mirrors) and translates.
+constexpr bool isAxisAligned( const glm::mat3& matrix ) noexcept
+{
+    return matrix[0][1] == 0.0f && matrix[1][0] == 0.0f && matrix[0][2] == 0.0f && matrix[1][2] == 0.0f && matrix[2][2] == 1.0f;
+}
+
+glm::mat3 Image::trimmedSpriteMatrix( const Sprite& sprite, const glm::mat3& _matrix ) noexcept
+{
+    // Only the visible (trimmed) part of the sprite is drawn.
+    // Move the origin of the sprite to the top-left corner of the trimmed rectangle so that the anchor of the sprite doesn't change.
+    const glm::vec2 offset = sprite.getTrimOffset();
+    glm::mat3       matrix = _matrix;
+    matrix[2] += matrix[0] * offset.x + matrix[1] * offset.y;
+
+    // Sprites are mirrored around their last pixel (not around their far edge),
+    // so the pixel at the origin of a mirrored sprite stays at the same position as before it was mirrored.
+    if ( isAxisAligned( matrix ) )
+    {
+        if ( matrix[0][0] < 0.0f )
+            matrix[2][0] += 1.0f;
+        if ( matrix[1][1] < 0.0f )
+            matrix[2][1] += 1.0f;
+    }
+
+    return matrix;
+}
+
+void Image::rasterSprite( const Sprite& sprite, const glm::mat3& _matrix, const Color& color, const AABB& clip ) noexcept
+{
+    const RectI&    trimRect    = sprite.getTrimRect();
+    const glm::mat3 matrix      = trimmedSpriteMatrix( sprite, _matrix );
+    const bool      axisAligned = isAxisAligned( matrix );
+
+    // Sprites that are only translated (and possibly mirrored) are copied row by row.
+    if ( axisAligned && std::abs( matrix[0][0] ) == 1.0f && std::abs( matrix[1][1] ) == 1.0f )
+    {
+        const bool mirrorX = matrix[0][0] < 0.0f;
+        const bool mirrorY = matrix[1][1] < 0.0f;
+
+        // Pick the same pixels as the general path: pixel centers that map inside the sprite.
+        const float tx = matrix[2][0] - 0.5f;
+        const float ty = matrix[2][1] - 0.5f;
+        const int   x  = mirrorX ? static_cast<int>( std::floor( tx ) ) - trimRect.width + 1 : static_cast<int>( std::ceil( tx ) );
+        const int   y  = mirrorY ? static_cast<int>( std::floor( ty ) ) - trimRect.height + 1 : static_cast<int>( std::ceil( ty ) );
+
+        blitSprite( sprite, x, y, mirrorX, mirrorY, color, clip );
+        return;
+    }
+
+    dispatchRasterState( sprite.getBlendMode(), color != Color::White, AddressMode::Clamp, [&]( auto state ) {
+        blitAffine<decltype( state )>( *sprite.getImage(), trimRect, matrix, color, sprite.getBlendMode(), clip );
+    } );
+}
+
+template<typename State>
+void Image::blitAffine( const Image& image, const RectI& srcRect, const glm::mat3& matrix, const Color& color, const BlendMode& blendMode, const AABB& clip ) noexcept
+{
+    // A degenerate transform doesn't cover any pixels.
+    if ( glm::determinant( matrix ) == 0.0f )
+        return;
+
+    const int w = srcRect.width;
+    const int h = srcRect.height;
+
+    // Compute an AABB over the transformed source rectangle.
+    const glm::vec2 p0 = matrix * glm::vec3 { 0, 0, 1 };
+    const glm::vec2 p1 = matrix * glm::vec3 { w, 0, 1 };
+    const glm::vec2 p2 = matrix * glm::vec3 { w, h, 1 };
+    const glm::vec2 p3 = matrix * glm::vec3 { 0, h, 1 };
+
+    const AABB aabb {
+        { p0, 0.0f },
+        { p1, 0.0f },
+        { p2, 0.0f },
+        { p3, 0.0f }
+    };
+
+    // The pixels that are (partially) covered by the AABB of the sprite.
+    // The clip bounds are pixel coordinates, so a sprite that starts inside the last pixel of the clip bounds still covers it.
+    const glm::vec2 min = glm::floor( glm::vec2 { aabb.min } );
+    const glm::vec2 max = glm::floor( glm::vec2 { aabb.max } );
+
+    // Check if the AABB of the sprite is inside the clip bounds.
+    if ( max.x < clip.min.x || max.y < clip.min.y || min.x > clip.max.x || min.y > clip.max.y )
+        return;
+
+    // Clamp to the clip bounds.
+    const int minX = static_cast<int>( std::max( min.x, clip.min.x ) );
+    const int minY = static_cast<int>( std::max( min.y, clip.min.y ) );
+    const int maxX = static_cast<int>( std::min( max.x, clip.max.x ) );
+    const int maxY = static_cast<int>( std::min( max.y, clip.max.y ) );
+
+    // Maps pixel centers in the image to texels in the source rectangle.
+    const glm::mat3 inv = glm::inverse( matrix );
+
+    // The change in texel coordinates for each step in x and y (in 16.16 fixed point).
+    constexpr float fixedScale = 65536.0f;
+
+    const glm::vec2 dx { inv[0] };
+    const glm::vec2 dy { inv[1] };
+    const int32_t   du = static_cast<int32_t>( std::lround( dx.x * fixedScale ) );
+    const int32_t   dv = static_cast<int32_t>( std::lround( dx.y * fixedScale ) );
+
+#pragma omp parallel for schedule( dynamic ) firstprivate( inv, dx, dy, du, dv ) if ( !m_deferred )
+    for ( int y = minY; y <= maxY; ++y )
+    {
+        // Texel coordinates at the center of the first pixel of the row.
+        // The fixed-point coordinates are stepped from the left edge of the sprite (not of the clip bounds),
+        // so the texels that are picked don't depend on the clip bounds (the tiles of a deferred image).
+        const glm::vec2 tLeft = inv * glm::vec3 { min.x + 0.5f, static_cast<float>( y ) + 0.5f, 1.0f };
+        const int64_t   skip  = static_cast<int64_t>( static_cast<float>( minX ) - min.x );
+        const glm::vec2 t0    = tLeft + dx * static_cast<float>( skip );
+
+        // Find the span of the row for which the texel coordinates are inside the source rectangle.
+        float start = 0.0f;
+        float end   = static_cast<float>( maxX - minX );
+
+        for ( int i = 0; i < 2; ++i )
+        {
+            const float size = static_cast<float>( i == 0 ? w : h );
+            if ( dx[i] == 0.0f )
+            {
+                if ( t0[i] < 0.0f || t0[i] >= size )
+                    end = -1.0f;
+            }
+            else
+            {
+                const float a = ( 0.0f - t0[i] ) / dx[i];
+                const float b = ( size - t0[i] ) / dx[i];
+                start         = std::max( start, std::min( a, b ) );
+                end           = std::min( end, std::max( a, b ) );
+            }
+        }
+
+        if ( start > end )
+            continue;
+
+        const int64_t u0 = std::llround( static_cast<double>( tLeft.x ) * fixedScale ) + du * skip;
+        const int64_t v0 = std::llround( static_cast<double>( tLeft.y ) * fixedScale ) + dv * skip;
+
+        // Texel of pixel i of the row.
+        auto texel = [&]( int i ) -> glm::ivec2 {
+            return { static_cast<int>( ( u0 + static_cast<int64_t>( du ) * i ) >> 16 ), static_cast<int>( ( v0 + static_cast<int64_t>( dv ) * i ) >> 16 ) };
+        };
+        auto inside = [&]( int i ) {
+            const glm::ivec2 t = texel( i );
+            return t.x >= 0 && t.x < w && t.y >= 0 && t.y < h;
+        };
+
+        // Snap the span to pixels and make sure the fixed-point texel coordinates
+        // don't step outside of the source rectangle at the ends of the span.
+        int i0 = static_cast<int>( std::ceil( start ) );
+        int i1 = std::min( static_cast<int>( std::ceil( end ) ), maxX - minX );
+
+        while ( i0 <= i1 && !inside( i0 ) )
+            ++i0;
+        while ( i1 >= i0 && !inside( i1 ) )
+            --i1;
+
+        if ( i0 > i1 )
+            continue;
+
+        // The texel coordinates are inside the source rectangle for the whole span, so they fit in 32 bits.
+        int32_t u = static_cast<int32_t>( u0 + static_cast<int64_t>( du ) * i0 ) + ( srcRect.left << 16 );
+        int32_t v = static_cast<int32_t>( v0 + static_cast<int64_t>( dv ) * i0 ) + ( srcRect.top << 16 );
+
+        // Gather the texels of the span and blend them in chunks.
+        Color* d = m_data.get() + static_cast<size_t>( y ) * m_width + minX;
+        Color  span[SpanBufferSize];
+        for ( int j0 = i0; j0 <= i1; j0 += SpanBufferSize )
+        {
+            const int n = std::min( i1 - j0 + 1, SpanBufferSize );
+            for ( int j = 0; j < n; ++j )
+            {
+                span[j] = State::shade( State::sample( image, u >> 16, v >> 16 ), color );
+
+                u += du;
+                v += dv;
+            }
+
+            State::blend( d + j0, span, n, blendMode );
+        }
+    }
+}
+
+void Image::rasterSprite( const Sprite& sprite, int x, int y, const AABB& clip ) noexcept
+{
+    const glm::ivec2 offset = sprite.getTrimOffset();
+    blitSprite( sprite, x + offset.x, y + offset.y, false, false, sprite.getColor(), clip );
+}
+
+void Image::blitSprite( const Sprite& sprite, int x, int y, bool mirrorX, bool mirrorY, const Color& color, const AABB& clip ) noexcept
+{
+    const Image*     image     = sprite.getImage().get();
+    const BlendMode  blendMode = sprite.getBlendMode();
+    const glm::ivec2 uv        = sprite.getTrimRect().topLeft();
+    const glm::ivec2 size      = { sprite.getTrimRect().width, sprite.getTrimRect().height };
+
+    // Destination coords (clipped to the clip rectangle).
+    const int dX = std::max( x, static_cast<int>( clip.min.x ) );
+    const int dY = std::max( y, static_cast<int>( clip.min.y ) );
+    const int dR = std::min( x + size.x, static_cast<int>( clip.max.x ) + 1 );
+    const int dB = std::min( y + size.y, static_cast<int>( clip.max.y ) + 1 );
+
+    // The size of the copy region.
+    const int w = dR - dX;
+    const int h = dB - dY;
+
+    // Check if the sprite is outside of the clip rectangle.
+    if ( w <= 0 || h <= 0 )
+        return;
+
+    // Source sprite coords (of the first pixel of the first row).
+    // Mirrored sprites are read from the opposite side of the sprite.
+    const int sX = mirrorX ? size.x - 1 - ( dX - x ) : dX - x;
+    const int sY = mirrorY ? size.y - 1 - ( dY - y ) : dY - y;
+
+    // Source image width.
+    const int iW = static_cast<int>( image->getWidth() );
+
+    const Color* src = image->data();
+    Color*       dst = m_data.get();
+
+    // Transparent pixels don't change the destination when the sprite is alpha blended, so only the visible runs are drawn.
+    const SpriteSpans* spans = sprite.getSpans();
+
+    dispatchRasterState( blendMode, color != Color::White, AddressMode::Clamp, [&]( auto state ) {
+        using State = decltype( state );
+
+        // Draw n pixels of a row (reading the source backwards if the sprite is mirrored horizontally).
+        // Copied pixels are not blended or tinted.
+        auto drawRow = [&]( Color* d, const Color* s, int n, bool copy ) {
+            if ( copy )
+            {
+                if ( mirrorX )
+                    std::reverse_copy( s - ( n - 1 ), s + 1, d );
+                else
+                    std::memcpy( d, s, n * sizeof( Color ) );
+            }
+            else if ( !State::modulate && !mirrorX )
+            {
+                State::blend( d, s, n, blendMode );
+            }
+            else
+            {
+                // Gather the mirrored and tinted source pixels and blend them in chunks.
+                Color span[SpanBufferSize];
+                for ( int j0 = 0; j0 < n; j0 += SpanBufferSize )
+                {
+                    const int c = std::min( n - j0, SpanBufferSize );
+                    if ( mirrorX )
+                    {
+                        for ( int j = 0; j < c; ++j )
+                            span[j] = State::shade( s[-( j0 + j )], color );
+                    }
+                    else
+                    {
+                        for ( int j = 0; j < c; ++j )
+                            span[j] = State::shade( s[j0 + j], color );
+                    }
+
+                    State::blend( d + j0, span, c, blendMode );
+                }
+            }
+        };
+
+        // Fully transparent pixels only have no effect if the (premultiplied) color is also zero.
+        bool skipTransparent = false;
+        if constexpr ( State::blendPreset == BlendPreset::AlphaBlend )
+            skipTransparent = spans != nullptr;
+        else if constexpr ( State::blendPreset == BlendPreset::PremultipliedAlpha )
+            skipTransparent = spans != nullptr && image->isPremultiplied();
+
+        // The range of sprite columns that are visible in each row.
+        const int colMin = mirrorX ? sX - w + 1 : sX;
+        const int colMax = colMin + w;
+
+#pragma omp parallel for if ( !m_deferred )
+        for ( int i = 0; i < h; ++i )
+        {
+            const int row = mirrorY ? sY - i : sY + i;
+
+            const Color* s = src + static_cast<size_t>( uv.y + row ) * iW + ( uv.x + sX );
+            Color*       d = dst + static_cast<size_t>( dY + i ) * m_width + dX;
+
+            if ( skipTransparent )
+            {
+                for ( const SpriteSpans::Run& run: spans->getRow( row ) )
+                {
+                    const int r0 = std::max( static_cast<int>( run.x ), colMin );
+                    const int r1 = std::min( static_cast<int>( run.x + run.length ), colMax );
+                    if ( r0 >= r1 )
+                        continue;
+
+                    // The offset of the first pixel of the run in the destination row.
+                    const int j = mirrorX ? sX - ( r1 - 1 ) : r0 - sX;
+                    drawRow( d + j, mirrorX ? s - j : s + j, r1 - r0, run.opaque && !State::modulate );
+                }
+            }
+            else
+            {
+                drawRow( d, s, w, State::blendPreset == BlendPreset::Disable && !State::modulate );
+            }
+        }
+    } );
+}
+
+void Image::drawMask( const std::shared_ptr<const AlphaImage>& mask, const RectI& _srcRect, int x, int y, const Color& color, int step ) noexcept
+{
+    if ( !mask || !*mask || color.a == 0 || step < 1 )
+        return;
+
+    // Clamp the source rectangle to the mask (skipping whole steps on the left).
+    const RectI rect = mask->getRect();
+    const int   skip = std::max( ( -_srcRect.left + step - 1 ) / step, 0 );
+    const int   top  = std::max( _srcRect.top, 0 );
+    const int   left = _srcRect.left + skip * step;
+
+    const int right  = std::min( _srcRect.left + _srcRect.width, rect.width );
+    const int bottom = std::min( _srcRect.top + _srcRect.height, rect.height );
+
+    if ( right <= left || bottom <= top )
+        return;
+
+    const RectI srcRect { left, top, right - left, bottom - top };
+    x += skip;
+    y += top - _srcRect.top;
+
+    m_generation = nextGeneration();
+
+    if ( m_deferred )
+    {
+        m_tiledRenderer->record( TiledRenderer::MaskCommand { mask, mask->getGeneration(), srcRect, x, y, color, step } );
+        return;
+    }
+
+    rasterMask( *mask, srcRect, x, y, color, step, m_AABB );
+}
+
+void Image::rasterMask( const AlphaImage& mask, const RectI& srcRect, int x, int y, const Color& color, int step, const AABB& clip ) noexcept
+{
+    // Destination coords (clipped to the clip rectangle).
+    const int dX = std::max( x, static_cast<int>( clip.min.x ) );
+    const int dY = std::max( y, static_cast<int>( clip.min.y ) );
+    const int dR = std::min( x + ( srcRect.width + step - 1 ) / step, static_cast<int>( clip.max.x ) + 1 );
+    const int dB = std::min( y + srcRect.height, static_cast<int>( clip.max.y ) + 1 );
+
+    const int w = dR - dX;
+    const int h = dB - dY;
+
+    if ( w <= 0 || h <= 0 )
+        return;
+
+    const int      mW  = static_cast<int>( mask.getWidth() );
+    const uint8_t* src = mask.data() + static_cast<size_t>( srcRect.top + dY - y ) * mW + ( srcRect.left + ( dX - x ) * step );
+    Color*         dst = m_data.get() + static_cast<size_t>( dY ) * m_width + dX;
+
+#pragma omp parallel for if ( !m_deferred )
+    for ( int i = 0; i < h; ++i )
+    {
+        const uint8_t* s = src + static_cast<size_t>( i ) * mW;
+        Color*         d = dst + static_cast<size_t>( i ) * m_width;
+
+        // Gather the runs of covered pixels and blend them in chunks.
+        // Pixels without coverage are skipped (they would not change the color, but they would change the alpha of the image).
+        int j = 0;
+        while ( j < w )
+        {
+            while ( j < w && s[j * step] == 0 )
+                ++j;
+
+            Color span[SpanBufferSize];
+            int   n = 0;
+            while ( j + n < w && n < SpanBufferSize && s[( j + n ) * step] != 0 )
+            {
+                span[n] = Color { color.r, color.g, color.b, static_cast<uint8_t>( s[( j + n ) * step] * color.a / 255 ) };
+                ++n;
+            }
+
+            if ( n > 0 )
+                blendSpan<BlendPreset::AlphaBlend>( d + j, span, n, BlendMode::AlphaBlend );
+
+            j += n;
+        }
+    }
+}
+
+void Image::drawSDF( const std::shared_ptr<const AlphaImage>& sdf, const RectI& _srcRect, const glm::vec2& position, float scale, const SDFStyle& style ) noexcept
+{
+    if ( !sdf || !*sdf || scale <= 0.0f )
+        return;
+
+    // Clamp the source rectangle to the distance field.
+    const RectI rect   = sdf->getRect();
+    const int   left   = std::max( _srcRect.left, 0 );
+    const int   top    = std::max( _srcRect.top, 0 );
+    const int   right  = std::min( _srcRect.left + _srcRect.width, rect.width );
+    const int   bottom = std::min( _srcRect.top + _srcRect.height, rect.height );
+
+    if ( right <= left || bottom <= top )
+        return;
+
+    const RectI     srcRect { left, top, right - left, bottom - top };
+    const glm::vec2 pos = position + glm::vec2 { left - _srcRect.left, top - _srcRect.top } * scale;
+
+    m_generation = nextGeneration();
+
+    if ( m_deferred )
+    {
+        m_tiledRenderer->record( TiledRenderer::SDFCommand { sdf, sdf->getGeneration(), srcRect, pos, scale, style } );
+        return;
+    }
+
+    rasterSDF( *sdf, srcRect, pos, scale, style, m_AABB );
+}
+
+void Image::rasterSDF( const AlphaImage& sdf, const RectI& srcRect, const glm::vec2& position, float scale, const SDFStyle& style, const AABB& clip ) noexcept
+{
+    const bool      shadow       = style.shadowColor.a > 0;
+    const bool      outline      = style.outlineWidth > 0.0f && style.outlineColor.a > 0;
+    const glm::vec2 shadowOffset = shadow ? style.shadowOffset : glm::vec2 { 0.0f };
+
+    // The screen area that is covered by the distance field and its shadow.
+    const glm::vec2 size = glm::vec2 { srcRect.width, srcRect.height } * scale;
+    const glm::vec2 min  = glm::min( position, position + shadowOffset );
+    const glm::vec2 max  = glm::max( position + size, position + size + shadowOffset );
+
+    const int x0 = std::max( static_cast<int>( std::floor( min.x ) ), static_cast<int>( clip.min.x ) );
+    const int y0 = std::max( static_cast<int>( std::floor( min.y ) ), static_cast<int>( clip.min.y ) );
+    const int x1 = std::min( static_cast<int>( std::ceil( max.x ) ), static_cast<int>( clip.max.x ) + 1 );
+    const int y1 = std::min( static_cast<int>( std::ceil( max.y ) ), static_cast<int>( clip.max.y ) + 1 );
+
+    if ( x1 <= x0 || y1 <= y0 )
+        return;
+
+    const float invScale = 1.0f / scale;
+    // Converts a value of the distance field to a distance (in pixels on the screen) to the edge (positive inside the shape).
+    const float toScreen = scale / style.distanceScale;
+    const float edge     = static_cast<float>( style.edge );
+
+    // Texels outside of the source rectangle are outside of the shape.
+    auto texel = [&]( int u, int v ) -> float {
+        if ( static_cast<unsigned>( u ) >= static_cast<unsigned>( srcRect.width ) || static_cast<unsigned>( v ) >= static_cast<unsigned>( srcRect.height ) )
+            return 0.0f;
+
+        return static_cast<float>( sdf( static_cast<uint32_t>( srcRect.left + u ), static_cast<uint32_t>( srcRect.top + v ) ) );
+    };
+
+    // The (bilinear filtered) distance to the edge of the shape at a texture coordinate of the source rectangle.
+    auto distance = [&]( float u, float v ) -> float {
+        const float fu = std::floor( u );
+        const float fv = std::floor( v );
+        const int   iu = static_cast<int>( fu );
+        const int   iv = static_cast<int>( fv );
+        const float tu = u - fu;
+        const float tv = v - fv;
+
+        const float a = texel( iu, iv ) + ( texel( iu + 1, iv ) - texel( iu, iv ) ) * tu;
+        const float b = texel( iu, iv + 1 ) + ( texel( iu + 1, iv + 1 ) - texel( iu, iv + 1 ) ) * tu;
+
+        return ( a + ( b - a ) * tv - edge ) * toScreen;
+    };
+
+    // The coverage of a pixel at a distance to the edge, smoothed over one pixel (plus the softness of the edge).
+    auto coverage = []( float d, float softness ) -> float {
+        const float t = std::clamp( ( d + 0.5f + softness ) / ( 1.0f + softness ), 0.0f, 1.0f );
+        return t * t * ( 3.0f - 2.0f * t );
+    };
+
+#pragma omp parallel for if ( !m_deferred )
+    for ( int y = y0; y < y1; ++y )
+    {
+        Color* d = m_data.get() + static_cast<size_t>( y ) * m_width;
+        Color  span[SpanBufferSize];
+        int    n = 0;
+        int    spanX = x0;
+
+        const float v = ( static_cast<float>( y ) + 0.5f - position.y ) * invScale - 0.5f;
+
+        for ( int x = x0; x <= x1; ++x )
+        {
+            // Composite the fill over the outline over the shadow (with premultiplied alpha).
+            float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+            if ( x < x1 )
+            {
+                auto over = [&]( const Color& c, float cov ) {
+                    const float ca = static_cast<float>( c.a ) / 255.0f * cov;
+                    r              = static_cast<float>( c.r ) * ca + r * ( 1.0f - ca );
+                    g              = static_cast<float>( c.g ) * ca + g * ( 1.0f - ca );
+                    b              = static_cast<float>( c.b ) * ca + b * ( 1.0f - ca );
+                    a              = ca + a * ( 1.0f - ca );
+                };
+
+                const float u    = ( static_cast<float>( x ) + 0.5f - position.x ) * invScale - 0.5f;
+                const float dist = distance( u, v );
+
+                if ( shadow )
+                    over( style.shadowColor, coverage( distance( u - shadowOffset.x * invScale, v - shadowOffset.y * invScale ) + ( outline ? style.outlineWidth : 0.0f ), style.shadowSoftness ) );
+                if ( outline )
+                    over( style.outlineColor, coverage( dist + style.outlineWidth, 0.0f ) );
+
+                over( style.color, coverage( dist, 0.0f ) );
+            }
+
+            // Pixels without coverage end the current span (they are skipped to keep the alpha of the image).
+            const uint8_t alpha = static_cast<uint8_t>( a * 255.0f + 0.5f );
+            if ( alpha > 0 )
+            {
+                if ( n == 0 )
+                    spanX = x;
+
+                const float inv = 1.0f / a;
+                span[n++]       = Color { static_cast<uint8_t>( r * inv + 0.5f ), static_cast<uint8_t>( g * inv + 0.5f ), static_cast<uint8_t>( b * inv + 0.5f ), alpha };
+            }
+
+            if ( n > 0 && ( alpha == 0 || n == SpanBufferSize ) )
+            {
+                blendSpan<BlendPreset::AlphaBlend>( d + spanX, span, n, BlendMode::AlphaBlend );
+                n = 0;
+            }
+        }
+    }
+}
+
+void Image::drawText( const Font& font, std::string_view text, int x, int y, const Color& color )
 {
     font.drawText( *this, text, x, y, color );
 }
 
-void Image::drawText( const Font& font, std::wstring_view text, int x, int y, const Color& color ) noexcept
+void Image::drawText( const Font& font, std::wstring_view text, int x, int y, const Color& color )
 {
     font.drawText( *this, text, x, y, color );
 }
 
+void Image::drawTextShadow( const Font& font, std::string_view text, int x, int y, const Color& color, const Color& shadowColor, const glm::ivec2& shadowOffset )
+{
+    font.drawTextShadow( *this, text, x, y, color, shadowColor, shadowOffset );
+}
+
+void Image::drawTextOutline( const Font& font, std::string_view text, int x, int y, const Color& color, const Color& outlineColor )
+{
+    font.drawTextOutline( *this, text, x, y, color, outlineColor );
+}
+
 constexpr int fast_floor( float x ) noexcept
 {
     return static_cast<int>( static_cast<double>( x ) + 1073741823.0 ) - 1073741823;
@@ -641,35 +1471,48 @@ constexpr int fast_mod( int x, int y ) noexcept
     return x - y * fast_floor( static_cast<float>( x ) / static_cast<float>( y ) );
 }
 
-const Color& Image::sample( int u, int v, AddressMode addressMode ) const noexcept
+template<AddressMode A>
+const Color& Image::sample( int u, int v ) const noexcept
 {
     const int w = static_cast<int>( m_width );
     const int h = static_cast<int>( m_height );
 
-    switch ( addressMode )
-    {
-    case AddressMode::Wrap:
+    if constexpr ( A == AddressMode::Wrap )
     {
         u = fast_mod( u, w );
         v = fast_mod( v, h );
     }
-    break;
-    case AddressMode::Mirror:
+    else if constexpr ( A == AddressMode::Mirror )
     {
         u = u / w % 2 == 0 ? fast_mod( u, w ) : ( w - 1 ) - fast_mod( u, w );
         v = v / h % 2 == 0 ? fast_mod( v, h ) : ( h - 1 ) - fast_mod( v, h );
     }
-    break;
-    case AddressMode::Clamp:
+    else if constexpr ( A == AddressMode::Clamp )
     {
         u = std::clamp( u, 0, w - 1 );
         v = std::clamp( v, 0, h - 1 );
     }
-    break;
-    }
 
     assert( u >= 0 && u < w );
     assert( v >= 0 && v < h );
 
     return m_data[static_cast<uint64_t>( v ) * m_width + u];
 }
+
+template const Color& Image::sample<AddressMode::Wrap>( int u, int v ) const noexcept;
+template const Color& Image::sample<AddressMode::Mirror>( int u, int v ) const noexcept;
+template const Color& Image::sample<AddressMode::Clamp>( int u, int v ) const noexcept;
+
+const Color& Image::sample( int u, int v, AddressMode addressMode ) const noexcept
+{
+    switch ( addressMode )
+    {
+    case AddressMode::Wrap:
+        return sample<AddressMode::Wrap>( u, v );
+    case AddressMode::Mirror:
+        return sample<AddressMode::Mirror>( u, v );
+    case AddressMode::Clamp:
+    default:
+        return sample<AddressMode::Clamp>( u, v );
+    }
+}
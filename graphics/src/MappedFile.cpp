@@ -0,0 +1,77 @@
+#include "MappedFile.hpp"
+
+#if defined( _WIN32 )
+#include "Win32/IncludeWin32.hpp"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Graphics;
+
+#if defined( _WIN32 )
+
+MappedFile::MappedFile( const std::filesystem::path& path )
+{
+    m_file = ::CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if ( m_file == INVALID_HANDLE_VALUE )
+    {
+        m_file = nullptr;
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if ( !::GetFileSizeEx( m_file, &size ) || size.QuadPart == 0 )
+        return;
+
+    m_mapping = ::CreateFileMappingW( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( !m_mapping )
+        return;
+
+    m_data = static_cast<const std::byte*>( ::MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+    if ( m_data )
+        m_size = static_cast<size_t>( size.QuadPart );
+}
+
+MappedFile::~MappedFile()
+{
+    if ( m_data )
+        ::UnmapViewOfFile( m_data );
+    if ( m_mapping )
+        ::CloseHandle( m_mapping );
+    if ( m_file )
+        ::CloseHandle( m_file );
+}
+
+#else
+
+MappedFile::MappedFile( const std::filesystem::path& path )
+{
+    const int file = ::open( path.c_str(), O_RDONLY );
+    if ( file < 0 )
+        return;
+
+    struct stat status;
+    if ( ::fstat( file, &status ) == 0 && status.st_size > 0 )
+    {
+        void* data = ::mmap( nullptr, static_cast<size_t>( status.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+        if ( data != MAP_FAILED )
+        {
+            m_data = static_cast<const std::byte*>( data );
+            m_size = static_cast<size_t>( status.st_size );
+        }
+    }
+
+    // The mapping stays valid after the file is closed.
+    ::close( file );
+}
+
+MappedFile::~MappedFile()
+{
+    if ( m_data )
+        ::munmap( const_cast<std::byte*>( m_data ), m_size );
+}
+
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace Graphics
+{
+/// <summary>
+/// A read-only view of a file that is mapped into memory.
+/// The pages of the file are loaded by the operating system when they are accessed (and are shared with the file cache),
+/// so reading a mapped file doesn't copy the file to an intermediate buffer.
+/// </summary>
+class MappedFile final
+{
+public:
+    /// <summary>
+    /// Map a file into memory.
+    /// </summary>
+    /// <param name="path">The file to map.</param>
+    explicit MappedFile( const std::filesystem::path& path );
+    ~MappedFile();
+
+    MappedFile( const MappedFile& )            = delete;
+    MappedFile( MappedFile&& )                 = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+    MappedFile& operator=( MappedFile&& )      = delete;
+
+    /// <summary>
+    /// Get the contents of the file (empty if the file could not be mapped).
+    /// </summary>
+    std::span<const std::byte> data() const noexcept
+    {
+        return { m_data, m_size };
+    }
+
+    /// <summary>
+    /// Check if the file was mapped.
+    /// </summary>
+    explicit operator bool() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+private:
+    const std::byte* m_data = nullptr;
+    size_t           m_size = 0u;
+
+#if defined( _WIN32 )
+    void* m_file    = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+}  // namespace Graphics
@@ -0,0 +1,142 @@
+#include "PixelFormat.hpp"
+
+#include <emmintrin.h>
+#if defined( __AVX__ ) || defined( __SSSE3__ )
+#include <tmmintrin.h>
+#endif
+
+#include <algorithm>
+
+using namespace Graphics;
+
+namespace
+{
+// Swap the first and the third byte of each pixel (RGBA <-> BGRA).
+// Uses the SSSE3 byte shuffle when it is available (MSVC only defines __AVX__, which the project enables with /arch:AVX2).
+void swapRedBlue( uint8_t* dst, const uint8_t* src, size_t count ) noexcept
+{
+    size_t i = 0;
+
+#if defined( __AVX__ ) || defined( __SSSE3__ )
+    const __m128i shuffle = _mm_setr_epi8( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 );
+
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const __m128i p = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i * 4 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i * 4 ), _mm_shuffle_epi8( p, shuffle ) );
+    }
+#else
+    // SSE2 doesn't have a byte shuffle: move the red and blue bytes with shifts instead.
+    const __m128i ga = _mm_set1_epi32( static_cast<int>( 0xFF00FF00u ) );
+    const __m128i rb = _mm_set1_epi32( 0x000000FF );
+
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const __m128i p = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i * 4 ) );
+        const __m128i r = _mm_or_si128( _mm_and_si128( _mm_srli_epi32( p, 16 ), rb ), _mm_slli_epi32( _mm_and_si128( p, rb ), 16 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i * 4 ), _mm_or_si128( _mm_and_si128( p, ga ), r ) );
+    }
+#endif
+
+    for ( ; i < count; ++i )
+    {
+        const uint8_t r = src[i * 4 + 0];
+        const uint8_t g = src[i * 4 + 1];
+        const uint8_t b = src[i * 4 + 2];
+        const uint8_t a = src[i * 4 + 3];
+
+        dst[i * 4 + 0] = b;
+        dst[i * 4 + 1] = g;
+        dst[i * 4 + 2] = r;
+        dst[i * 4 + 3] = a;
+    }
+}
+
+// Multiply the 16-bit channels of two pixels by their alpha (in the 4th and 8th lane) and divide by 255.
+__m128i premultiply2( __m128i p ) noexcept
+{
+    // Broadcast the alpha of each pixel to all of its channels, but keep the alpha channel itself (multiply it by 255).
+    __m128i a = _mm_shufflehi_epi16( _mm_shufflelo_epi16( p, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    a         = _mm_or_si128( _mm_andnot_si128( _mm_setr_epi16( 0, 0, 0, -1, 0, 0, 0, -1 ), a ), _mm_setr_epi16( 0, 0, 0, 255, 0, 0, 0, 255 ) );
+
+    // x / 255 == ( x * 0x8081 ) >> 23 for all products of two 8-bit values.
+    const __m128i x = _mm_mullo_epi16( p, a );
+    return _mm_srli_epi16( _mm_mulhi_epu16( x, _mm_set1_epi16( static_cast<short>( 0x8081 ) ) ), 7 );
+}
+}  // namespace
+
+void PixelFormat::fromRGBA( Color* dst, const uint8_t* src, size_t count ) noexcept
+{
+    swapRedBlue( reinterpret_cast<uint8_t*>( dst ), src, count );
+}
+
+void PixelFormat::toRGBA( uint8_t* dst, const Color* src, size_t count ) noexcept
+{
+    swapRedBlue( dst, reinterpret_cast<const uint8_t*>( src ), count );
+}
+
+void PixelFormat::premultiply( Color* dst, const Color* src, size_t count ) noexcept
+{
+    size_t i = 0;
+
+    const __m128i zero = _mm_setzero_si128();
+
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        const __m128i p  = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i ) );
+        const __m128i lo = premultiply2( _mm_unpacklo_epi8( p, zero ) );
+        const __m128i hi = premultiply2( _mm_unpackhi_epi8( p, zero ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), _mm_packus_epi16( lo, hi ) );
+    }
+
+    for ( ; i < count; ++i )
+    {
+        const Color c = src[i];
+        dst[i]        = c * Color { c.a, c.a, c.a };
+    }
+}
+
+void PixelFormat::unpremultiply( Color* dst, const Color* src, size_t count ) noexcept
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const Color c = src[i];
+
+        if ( c.a == 0 )
+        {
+            dst[i] = Color { 0, 0, 0, 0 };
+        }
+        else if ( c.a == 255 )
+        {
+            dst[i] = c;
+        }
+        else
+        {
+            // Round up, so that premultiplying the result gives the source color again.
+            const auto div = [a = c.a]( uint8_t x ) {
+                return static_cast<uint8_t>( std::min( ( x * 255 + a - 1 ) / a, 255 ) );
+            };
+            dst[i] = Color { div( c.r ), div( c.g ), div( c.b ), c.a };
+        }
+    }
+}
+
+void PixelFormat::extractAlpha( uint8_t* dst, const Color* src, size_t count ) noexcept
+{
+    size_t i = 0;
+
+    for ( ; i + 16 <= count; i += 16 )
+    {
+        // Shift the alpha channel of each pixel to the low byte, then pack 16 pixels to 16 bytes.
+        const __m128i p0 = _mm_srli_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i + 0 ) ), 24 );
+        const __m128i p1 = _mm_srli_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i + 4 ) ), 24 );
+        const __m128i p2 = _mm_srli_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i + 8 ) ), 24 );
+        const __m128i p3 = _mm_srli_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( src + i + 12 ) ), 24 );
+
+        const __m128i a = _mm_packus_epi16( _mm_packs_epi32( p0, p1 ), _mm_packs_epi32( p2, p3 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), a );
+    }
+
+    for ( ; i < count; ++i )
+        dst[i] = src[i].a;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Graphics/Color.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Conversions between the pixel format of images (Color: 8-bit BGRA in memory) and the formats used by
+/// image files and other libraries (8-bit RGBA, 8-bit alpha). The conversions process 16 bytes at a time
+/// with SIMD instructions and fall back to scalar loops for the remaining pixels.
+/// The RGBA/BGRA swizzle uses a byte shuffle (pshufb) when SSSE3 or AVX is enabled and SSE2 shifts otherwise.
+/// The source and the destination may be the same buffer (the conversion is done in place).
+/// </summary>
+namespace Graphics::PixelFormat
+{
+/// <summary>
+/// Convert 8-bit RGBA pixels (as loaded by stb_image) to colors.
+/// </summary>
+/// <param name="dst">The destination colors.</param>
+/// <param name="src">The source RGBA pixels (4 bytes per pixel).</param>
+/// <param name="count">The number of pixels to convert.</param>
+void fromRGBA( Color* dst, const uint8_t* src, size_t count ) noexcept;
+
+/// <summary>
+/// Convert colors to 8-bit RGBA pixels (as expected by stb_image_write).
+/// </summary>
+/// <param name="dst">The destination RGBA pixels (4 bytes per pixel).</param>
+/// <param name="src">The source colors.</param>
+/// <param name="count">The number of pixels to convert.</param>
+void toRGBA( uint8_t* dst, const Color* src, size_t count ) noexcept;
+
+/// <summary>
+/// Multiply the color channels by the alpha channel.
+/// Uses the same rounding as <see cref="Color::operator*"/> (<c>c * a / 255</c>).
+/// </summary>
+/// <param name="dst">The destination (premultiplied) colors.</param>
+/// <param name="src">The source (straight alpha) colors.</param>
+/// <param name="count">The number of pixels to convert.</param>
+void premultiply( Color* dst, const Color* src, size_t count ) noexcept;
+
+/// <summary>
+/// Divide the color channels by the alpha channel (the inverse of premultiply).
+/// Premultiplying the result gives the source colors again. Fully transparent pixels become transparent black.
+/// </summary>
+/// <param name="dst">The destination (straight alpha) colors.</param>
+/// <param name="src">The source (premultiplied) colors.</param>
+/// <param name="count">The number of pixels to convert.</param>
+void unpremultiply( Color* dst, const Color* src, size_t count ) noexcept;
+
+/// <summary>
+/// Extract the alpha channel of colors (RGBA8 to A8).
+/// </summary>
+/// <param name="dst">The destination alpha values.</param>
+/// <param name="src">The source colors.</param>
+/// <param name="count">The number of pixels to convert.</param>
+void extractAlpha( uint8_t* dst, const Color* src, size_t count ) noexcept;
+
+}  // namespace Graphics::PixelFormat
@@ -0,0 +1,605 @@
+#pragma once
+
+#include <Math/AABB.hpp>
+#include <Math/OutCodes.hpp>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <emmintrin.h>
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace Graphics::Rasterizer
+{
+/// <summary>
+/// The number of sub-pixel bits used to snap vertices to the fixed-point grid (28.4).
+/// </summary>
+constexpr int SubPixelBits  = 4;
+constexpr int SubPixelScale = 1 << SubPixelBits;
+
+/// <summary>
+/// The width and height (in pixels) of the blocks that are tested against the triangle edges.
+/// </summary>
+constexpr int BlockSize = 8;
+
+/// <summary>
+/// Triangles with vertices further than this (in pixels) from the origin are not rasterized.
+/// This guarantees that the edge functions fit in 32-bit integers inside a block.
+/// </summary>
+constexpr float GuardBand = static_cast<float>( 1 << 16 );
+
+/// <summary>
+/// Shapes with fewer rows than this are rasterized on the calling thread:
+/// for small shapes (like debug overlays) starting a parallel region costs more than filling the rows.
+/// </summary>
+constexpr int MinParallelRows = 64;
+
+/// <summary>
+/// Interpolates the barycentric coordinates of a triangle at pixel centers.
+/// </summary>
+class Barycentric
+{
+public:
+    Barycentric( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2 ) noexcept
+    : origin { p0 + glm::vec2 { -0.5f } }  // Sample at pixel centers.
+    {
+        const glm::vec2 e1 = p1 - p0;
+        const glm::vec2 e2 = p2 - p0;
+
+        const float area = e1.x * e2.y - e1.y * e2.x;
+        const float inv  = area != 0.0f ? 1.0f / area : 0.0f;
+
+        b1 = glm::vec2 { e2.y, -e2.x } * inv;
+        b2 = glm::vec2 { -e1.y, e1.x } * inv;
+    }
+
+    /// <summary>
+    /// Compute the barycentric coordinates at the center of pixel (x, y).
+    /// </summary>
+    glm::vec3 operator()( int x, int y ) const noexcept
+    {
+        const float dx = static_cast<float>( x ) - origin.x;
+        const float dy = static_cast<float>( y ) - origin.y;
+
+        const float u = b1.x * dx + b1.y * dy;
+        const float v = b2.x * dx + b2.y * dy;
+
+        return { 1.0f - u - v, u, v };
+    }
+
+private:
+    glm::vec2 origin;
+    glm::vec2 b1;
+    glm::vec2 b2;
+};
+
+namespace detail
+{
+// An edge function in fixed point: E(x, y) = a * x + b * y + c, evaluated at the center of pixel (x, y).
+// A pixel is inside the edge if E >= 0.
+struct Edge
+{
+    int32_t a;
+    int32_t b;
+    int64_t c;
+};
+
+inline Edge makeEdge( const glm::ivec2& v0, const glm::ivec2& v1 ) noexcept
+{
+    const int32_t dx = v1.x - v0.x;
+    const int32_t dy = v1.y - v0.y;
+
+    // Top-left fill rule: pixels exactly on an edge are only filled if the edge is a top or left edge.
+    const bool    topLeft = dy < 0 || ( dy == 0 && dx > 0 );
+    const int64_t bias    = topLeft ? 0 : -1;
+
+    constexpr int64_t half = SubPixelScale / 2;
+
+    return {
+        -dy * SubPixelScale,
+        dx * SubPixelScale,
+        static_cast<int64_t>( dx ) * ( half - v0.y ) - static_cast<int64_t>( dy ) * ( half - v0.x ) + bias
+    };
+}
+
+inline glm::ivec2 toFixed( const glm::vec2& p ) noexcept
+{
+    return { static_cast<int32_t>( std::lround( p.x * SubPixelScale ) ), static_cast<int32_t>( std::lround( p.y * SubPixelScale ) ) };
+}
+
+// Compute the coverage mask for (up to) 8 pixels of a row.
+// Bit i of the mask is set if pixel i of the row is inside all three edges.
+struct RowCoverage
+{
+    RowCoverage( const int32_t e[3], const int32_t a[3], const int32_t b[3] ) noexcept
+    {
+        for ( int i = 0; i < 3; ++i )
+        {
+#if defined( __AVX2__ )
+            row[i]  = _mm256_add_epi32( _mm256_set1_epi32( e[i] ), _mm256_set_epi32( 7 * a[i], 6 * a[i], 5 * a[i], 4 * a[i], 3 * a[i], 2 * a[i], a[i], 0 ) );
+            step[i] = _mm256_set1_epi32( b[i] );
+#else
+            lo[i]   = _mm_add_epi32( _mm_set1_epi32( e[i] ), _mm_set_epi32( 3 * a[i], 2 * a[i], a[i], 0 ) );
+            hi[i]   = _mm_add_epi32( lo[i], _mm_set1_epi32( 4 * a[i] ) );
+            step[i] = _mm_set1_epi32( b[i] );
+#endif
+        }
+    }
+
+    // Get the coverage mask of the current row and advance to the next row.
+    uint32_t next() noexcept
+    {
+#if defined( __AVX2__ )
+        const __m256i outside = _mm256_or_si256( _mm256_or_si256( row[0], row[1] ), row[2] );
+        const uint32_t mask = static_cast<uint32_t>( _mm256_movemask_ps( _mm256_castsi256_ps( outside ) ) );
+
+        for ( int i = 0; i < 3; ++i )
+            row[i] = _mm256_add_epi32( row[i], step[i] );
+#else
+        const __m128i outsideLo = _mm_or_si128( _mm_or_si128( lo[0], lo[1] ), lo[2] );
+        const __m128i outsideHi = _mm_or_si128( _mm_or_si128( hi[0], hi[1] ), hi[2] );
+        const uint32_t mask = static_cast<uint32_t>( _mm_movemask_ps( _mm_castsi128_ps( outsideLo ) ) | ( _mm_movemask_ps( _mm_castsi128_ps( outsideHi ) ) << 4 ) );
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            lo[i] = _mm_add_epi32( lo[i], step[i] );
+            hi[i] = _mm_add_epi32( hi[i], step[i] );
+        }
+#endif
+        // The sign bit is set for pixels that are outside of any edge.
+        return ~mask & 0xFFu;
+    }
+
+private:
+#if defined( __AVX2__ )
+    __m256i row[3];
+    __m256i step[3];
+#else
+    __m128i lo[3];
+    __m128i hi[3];
+    __m128i step[3];
+#endif
+};
+}  // namespace detail
+
+/// <summary>
+/// Rasterize a triangle using incremental edge functions.
+/// The vertices are snapped to 28.4 fixed point and pixels are sampled at their centers.
+/// The bounding box of the triangle is traversed in 8x8 blocks: blocks that are outside of any edge are skipped,
+/// blocks that are inside all edges are filled without testing, and the remaining blocks are tested 8 pixels at a time.
+/// Pixels that lie exactly on a shared edge are only filled by one of the triangles (top-left fill rule).
+/// </summary>
+/// <param name="p0">The first triangle vertex.</param>
+/// <param name="p1">The second triangle vertex.</param>
+/// <param name="p2">The third triangle vertex.</param>
+/// <param name="clip">The (inclusive) clip bounds in pixels.</param>
+/// <param name="parallel">Rasterize the rows of blocks in parallel.</param>
+/// <param name="shader">The function that is invoked with the (x, y) coordinates and the length of each covered horizontal span.</param>
+template<typename Shader>
+void triangle( const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2, const Math::AABB& clip, bool parallel, Shader&& shader ) noexcept
+{
+    for ( const glm::vec2& p: { p0, p1, p2 } )
+    {
+        if ( !( std::abs( p.x ) < GuardBand && std::abs( p.y ) < GuardBand ) )
+            return;
+    }
+
+    const glm::ivec2 v0 = detail::toFixed( p0 );
+    glm::ivec2       v1 = detail::toFixed( p1 );
+    glm::ivec2       v2 = detail::toFixed( p2 );
+
+    const int64_t area = static_cast<int64_t>( v1.x - v0.x ) * ( v2.y - v0.y ) - static_cast<int64_t>( v1.y - v0.y ) * ( v2.x - v0.x );
+
+    // Degenerate triangle.
+    if ( area == 0 )
+        return;
+
+    // Make sure the inside of the triangle is on the positive side of the edges.
+    if ( area < 0 )
+        std::swap( v1, v2 );
+
+    const detail::Edge edges[] = {
+        detail::makeEdge( v1, v2 ),
+        detail::makeEdge( v2, v0 ),
+        detail::makeEdge( v0, v1 ),
+    };
+
+    // Pixel bounds of the triangle (only pixels whose centers can be covered).
+    constexpr int half = SubPixelScale / 2;
+
+    int minX = ( std::min( { v0.x, v1.x, v2.x } ) - half + SubPixelScale - 1 ) >> SubPixelBits;
+    int minY = ( std::min( { v0.y, v1.y, v2.y } ) - half + SubPixelScale - 1 ) >> SubPixelBits;
+    int maxX = ( std::max( { v0.x, v1.x, v2.x } ) - half ) >> SubPixelBits;
+    int maxY = ( std::max( { v0.y, v1.y, v2.y } ) - half ) >> SubPixelBits;
+
+    minX = std::max( minX, static_cast<int>( clip.min.x ) );
+    minY = std::max( minY, static_cast<int>( clip.min.y ) );
+    maxX = std::min( maxX, static_cast<int>( clip.max.x ) );
+    maxY = std::min( maxY, static_cast<int>( clip.max.y ) );
+
+    if ( minX > maxX || minY > maxY )
+        return;
+
+    const int numBlockRows = ( maxY - minY ) / BlockSize + 1;
+
+#pragma omp parallel for schedule( dynamic ) firstprivate( edges ) if ( parallel )
+    for ( int blockRow = 0; blockRow < numBlockRows; ++blockRow )
+    {
+        const int y0 = minY + blockRow * BlockSize;
+        const int y1 = std::min( y0 + BlockSize - 1, maxY );
+
+        for ( int x0 = minX; x0 <= maxX; x0 += BlockSize )
+        {
+            const int x1 = std::min( x0 + BlockSize - 1, maxX );
+
+            int32_t e[3], a[3], b[3];
+            bool    outside = false;
+            bool    inside  = true;
+
+            for ( int i = 0; i < 3; ++i )
+            {
+                const detail::Edge& edge = edges[i];
+
+                // Evaluate the edge function at the corners of the block.
+                const int64_t e0   = edge.c + static_cast<int64_t>( edge.a ) * x0 + static_cast<int64_t>( edge.b ) * y0;
+                const int64_t eMin = e0 + static_cast<int64_t>( std::min( edge.a, 0 ) ) * ( x1 - x0 ) + static_cast<int64_t>( std::min( edge.b, 0 ) ) * ( y1 - y0 );
+                const int64_t eMax = e0 + static_cast<int64_t>( std::max( edge.a, 0 ) ) * ( x1 - x0 ) + static_cast<int64_t>( std::max( edge.b, 0 ) ) * ( y1 - y0 );
+
+                if ( eMax < 0 )
+                {
+                    outside = true;
+                    break;
+                }
+
+                if ( eMin >= 0 )
+                {
+                    // The whole block is inside this edge, it doesn't need to be tested.
+                    e[i] = a[i] = b[i] = 0;
+                }
+                else
+                {
+                    // The edge crosses the block, so the edge function is small enough to fit in 32 bits.
+                    e[i]   = static_cast<int32_t>( e0 );
+                    a[i]   = edge.a;
+                    b[i]   = edge.b;
+                    inside = false;
+                }
+            }
+
+            if ( outside )
+                continue;
+
+            if ( inside )
+            {
+                for ( int y = y0; y <= y1; ++y )
+                {
+                    shader( x0, y, x1 - x0 + 1 );
+                }
+            }
+            else
+            {
+                const uint32_t columns = ( 1u << ( x1 - x0 + 1 ) ) - 1u;
+
+                detail::RowCoverage coverage { e, a, b };
+                for ( int y = y0; y <= y1; ++y )
+                {
+                    uint32_t mask = coverage.next() & columns;
+                    while ( mask )
+                    {
+                        // Emit each run of covered pixels as a span.
+                        const int start = std::countr_zero( mask );
+                        const int count = std::countr_one( mask >> start );
+                        shader( x0 + start, y, count );
+                        mask &= ~( ( ( 1u << count ) - 1u ) << start );
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// <summary>
+/// The result of testing a line against the clip bounds.
+/// </summary>
+enum class LineClip
+{
+    Inside,   // Both end points are inside the bounds (the line doesn't need to be clipped).
+    Outside,  // Both end points are outside of the same edge (the line is not visible).
+    Partial,  // The line may cross the edge of the bounds and must be clipped.
+};
+
+/// <summary>
+/// Classify a line against the (inclusive) clip bounds using the Cohen-Sutherland outcodes of its end points.
+/// The four coordinates of the line (x0, y0, x1, y1) are compared against the bounds at once.
+/// </summary>
+/// <param name="line">The coordinates of the line: x0, y0, x1, y1.</param>
+/// <param name="min">The minimum of the clip bounds: min.x, min.y, min.x, min.y.</param>
+/// <param name="max">The maximum of the clip bounds: max.x, max.y, max.x, max.y.</param>
+inline LineClip classifyLine( __m128i line, __m128i min, __m128i max ) noexcept
+{
+    // Lane i of the masks is set if coordinate i of the line is less than the minimum (or greater than the maximum).
+    const int lt = _mm_movemask_ps( _mm_castsi128_ps( _mm_cmplt_epi32( line, min ) ) );
+    const int gt = _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpgt_epi32( line, max ) ) );
+
+    const auto outCode = []( int lt, int gt ) noexcept {
+        Math::OutCode code = Math::OutCode::Inside;
+        if ( lt & 1 )
+            code |= Math::OutCode::Left;
+        if ( gt & 1 )
+            code |= Math::OutCode::Right;
+        if ( lt & 2 )
+            code |= Math::OutCode::Bottom;
+        if ( gt & 2 )
+            code |= Math::OutCode::Top;
+        return code;
+    };
+
+    const Math::OutCode oc0 = outCode( lt, gt );
+    const Math::OutCode oc1 = outCode( lt >> 2, gt >> 2 );
+
+    if ( ( oc0 | oc1 ) == Math::OutCode::Inside )
+        return LineClip::Inside;
+    if ( ( oc0 & oc1 ) != Math::OutCode::Inside )
+        return LineClip::Outside;
+
+    return LineClip::Partial;
+}
+
+/// <summary>
+/// Rasterize a line with Bresenham's algorithm.
+/// The pixels are not emitted one at a time: consecutive pixels in the same row (for mostly horizontal lines)
+/// or in the same column (for mostly vertical lines) are collected into runs, and each run is emitted at once.
+/// The line must already be clipped to the image. Runs are clipped to the clip bounds, so the same pixels are plotted
+/// regardless of the clip bounds.
+/// </summary>
+/// <param name="x0">The x-coordinate of the start point.</param>
+/// <param name="y0">The y-coordinate of the start point.</param>
+/// <param name="x1">The x-coordinate of the end point.</param>
+/// <param name="y1">The y-coordinate of the end point.</param>
+/// <param name="clip">The (inclusive) clip bounds in pixels.</param>
+/// <param name="hspan">The function that is invoked with the (x, y) coordinates and the length of each horizontal run (from left to right).</param>
+/// <param name="vspan">The function that is invoked with the (x, y) coordinates and the length of each vertical run (from top to bottom).</param>
+template<typename HSpan, typename VSpan>
+void line( int x0, int y0, int x1, int y1, const Math::AABB& clip, HSpan&& hspan, VSpan&& vspan ) noexcept
+{
+    const int cx0 = static_cast<int>( clip.min.x );
+    const int cy0 = static_cast<int>( clip.min.y );
+    const int cx1 = static_cast<int>( clip.max.x );
+    const int cy1 = static_cast<int>( clip.max.y );
+
+    const int  dx     = std::abs( x1 - x0 );
+    const int  dy     = -std::abs( y1 - y0 );
+    const int  sx     = x0 < x1 ? 1 : -1;
+    const int  sy     = y0 < y1 ? 1 : -1;
+    const bool xMajor = dx >= -dy;
+
+    // Emit a run that ends at (x, y).
+    const auto flush = [&]( int x, int y, int count ) {
+        if ( xMajor )
+        {
+            if ( y < cy0 || y > cy1 )
+                return;
+
+            const int first = sx > 0 ? x - count + 1 : x;
+            const int left  = std::max( first, cx0 );
+            const int right = std::min( first + count - 1, cx1 );
+            if ( left <= right )
+                hspan( left, y, right - left + 1 );
+        }
+        else
+        {
+            if ( x < cx0 || x > cx1 )
+                return;
+
+            const int first  = sy > 0 ? y - count + 1 : y;
+            const int top    = std::max( first, cy0 );
+            const int bottom = std::min( first + count - 1, cy1 );
+            if ( top <= bottom )
+                vspan( x, top, bottom - top + 1 );
+        }
+    };
+
+    int err   = dx + dy;
+    int count = 0;   // The number of pixels in the current run.
+    int lastX = x0;  // The last pixel of the current run.
+    int lastY = y0;
+
+    while ( true )
+    {
+        // A step along the minor axis starts a new run.
+        if ( count > 0 && ( xMajor ? y0 != lastY : x0 != lastX ) )
+        {
+            flush( lastX, lastY, count );
+            count = 0;
+        }
+
+        ++count;
+        lastX = x0;
+        lastY = y0;
+
+        const int e2 = err * 2;
+
+        if ( e2 >= dy )
+        {
+            if ( x0 == x1 )
+                break;
+
+            err += dy;
+            x0 += sx;
+        }
+        if ( e2 <= dx )
+        {
+            if ( y0 == y1 )
+                break;
+
+            err += dx;
+            y0 += sy;
+        }
+    }
+
+    flush( lastX, lastY, count );
+}
+
+/// <summary>
+/// Rasterize an ellipse (or an elliptical ring) one row at a time.
+/// The extent of each row is computed exactly from the equation of the ellipse, so every covered pixel
+/// is emitted once as part of (at most two) horizontal spans. Pixels are sampled at their centers.
+/// </summary>
+/// <param name="center">The center of the ellipse.</param>
+/// <param name="radii">The horizontal and vertical radius of the ellipse.</param>
+/// <param name="thickness">The thickness of the ring (in pixels), or 0 to fill the whole ellipse.</param>
+/// <param name="clip">The (inclusive) clip bounds in pixels.</param>
+/// <param name="parallel">Rasterize the rows in parallel.</param>
+/// <param name="shader">The function that is invoked with the (x, y) coordinates and the length of each covered horizontal span.</param>
+template<typename Shader>
+void ellipse( const glm::vec2& center, const glm::vec2& radii, float thickness, const Math::AABB& clip, bool parallel, Shader&& shader ) noexcept
+{
+    if ( !( radii.x > 0.0f && radii.y > 0.0f ) || !( std::abs( center.x ) < GuardBand && std::abs( center.y ) < GuardBand && radii.x < GuardBand && radii.y < GuardBand ) )
+        return;
+
+    // Pixels whose centers are inside the inner ellipse are not part of the ring.
+    const glm::vec2 inner = radii - thickness;
+    const bool      ring  = thickness > 0.0f && inner.x > 0.0f && inner.y > 0.0f;
+
+    const int clipX0 = static_cast<int>( clip.min.x );
+    const int clipX1 = static_cast<int>( clip.max.x );
+    const int minY   = std::max( static_cast<int>( std::ceil( center.y - radii.y - 0.5f ) ), static_cast<int>( clip.min.y ) );
+    const int maxY   = std::min( static_cast<int>( std::floor( center.y + radii.y - 0.5f ) ), static_cast<int>( clip.max.y ) );
+
+    const auto span = [&]( int x0, int x1, int y ) {
+        x0 = std::max( x0, clipX0 );
+        x1 = std::min( x1, clipX1 );
+        if ( x0 <= x1 )
+            shader( x0, y, x1 - x0 + 1 );
+    };
+
+    const auto row = [&]( int y ) {
+        const float dy = static_cast<float>( y ) + 0.5f - center.y;
+        const float t  = 1.0f - ( dy * dy ) / ( radii.y * radii.y );
+        if ( t < 0.0f )
+            return;
+
+        const float hw = radii.x * std::sqrt( t );
+        const int   x0 = static_cast<int>( std::ceil( center.x - hw - 0.5f ) );
+        const int   x1 = static_cast<int>( std::floor( center.x + hw - 0.5f ) );
+
+        // The pixels of the row that are strictly inside of the inner ellipse.
+        int ix0 = 1;
+        int ix1 = 0;
+        if ( ring )
+        {
+            const float it = 1.0f - ( dy * dy ) / ( inner.y * inner.y );
+            if ( it > 0.0f )
+            {
+                const float ihw = inner.x * std::sqrt( it );
+                ix0             = static_cast<int>( std::floor( center.x - ihw - 0.5f ) ) + 1;
+                ix1             = static_cast<int>( std::ceil( center.x + ihw - 0.5f ) ) - 1;
+            }
+        }
+
+        if ( ix0 > ix1 )
+        {
+            span( x0, x1, y );
+        }
+        else
+        {
+            span( x0, ix0 - 1, y );
+            span( ix1 + 1, x1, y );
+        }
+    };
+
+    if ( parallel && maxY - minY + 1 >= MinParallelRows )
+    {
+#pragma omp parallel for schedule( dynamic )
+        for ( int y = minY; y <= maxY; ++y )
+            row( y );
+    }
+    else
+    {
+        for ( int y = minY; y <= maxY; ++y )
+            row( y );
+    }
+}
+
+/// <summary>
+/// Sample a horizontally scaled row of pixels with nearest-neighbour filtering.
+/// Destination pixel u samples source pixel <c>u * srcWidth / dstWidth</c>. Instead of dividing for each pixel,
+/// the source position is advanced with an exact fixed-point step: the quotient and the remainder of <c>srcWidth / dstWidth</c>.
+/// Integer magnifications (2x, 3x, ...) repeat each source pixel without stepping.
+/// </summary>
+/// <param name="dst">The destination pixels.</param>
+/// <param name="src">The source row.</param>
+/// <param name="u">The destination column of the first pixel (relative to the start of the scaled row).</param>
+/// <param name="count">The number of pixels to write to the destination.</param>
+/// <param name="srcWidth">The width of the source row.</param>
+/// <param name="dstWidth">The width of the scaled row.</param>
+template<typename T>
+void scaleRow( T* dst, const T* src, int u, int count, int srcWidth, int dstWidth ) noexcept
+{
+    if ( dstWidth % srcWidth == 0 )
+    {
+        const int scale = dstWidth / srcWidth;
+
+        src += u / scale;
+        int n = std::min( scale - u % scale, count );  // The first source pixel may already be partially written.
+
+        if constexpr ( sizeof( T ) == sizeof( uint32_t ) )
+        {
+            if ( scale == 2 )
+            {
+                if ( n == 1 )
+                {
+                    *dst++ = *src++;
+                    --count;
+                }
+
+                // Duplicate 4 source pixels into 8 destination pixels at once.
+                for ( ; count >= 8; count -= 8, src += 4, dst += 8 )
+                {
+                    const __m128i s = _mm_loadu_si128( reinterpret_cast<const __m128i*>( src ) );
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst ), _mm_unpacklo_epi32( s, s ) );
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + 4 ), _mm_unpackhi_epi32( s, s ) );
+                }
+
+                n = std::min( 2, count );
+            }
+        }
+
+        while ( count > 0 )
+        {
+            std::fill_n( dst, n, *src++ );
+            dst += n;
+            count -= n;
+            n = std::min( scale, count );
+        }
+        return;
+    }
+
+    const int step     = srcWidth / dstWidth;
+    const int stepFrac = srcWidth % dstWidth;
+
+    int x    = u * srcWidth / dstWidth;
+    int frac = u * srcWidth % dstWidth;
+
+    for ( int i = 0; i < count; ++i )
+    {
+        dst[i] = src[x];
+
+        x += step;
+        frac += stepFrac;
+        if ( frac >= dstWidth )
+        {
+            frac -= dstWidth;
+            ++x;
+        }
+    }
+}
+
+}  // namespace Graphics::Rasterizer
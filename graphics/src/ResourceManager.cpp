@@ -1,7 +1,11 @@
 #include <Graphics/ResourceManager.hpp>
 
+#include <chrono>
 #include <functional> // std::hash
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 using namespace Graphics;
 
@@ -14,10 +18,45 @@ struct FontKey
     float                 size;
     uint32_t              firstChar;
     uint32_t              numChars;
+    uint32_t              oversampling;
+    GlyphMode             glyphMode;
 
     bool operator==( const FontKey& other ) const
     {
-        return fontFile == other.fontFile && size == other.size && firstChar == other.firstChar && numChars == other.numChars;
+        return fontFile == other.fontFile && size == other.size && firstChar == other.firstChar && numChars == other.numChars && oversampling == other.oversampling && glyphMode == other.glyphMode;
+    }
+};
+
+/// <summary>
+/// A key used to uniquely identify an image.
+/// The same file can be loaded with and without premultiplied alpha.
+/// </summary>
+struct ImageKey
+{
+    std::filesystem::path filePath;
+    bool                  premultiplyAlpha;
+
+    bool operator==( const ImageKey& other ) const
+    {
+        return filePath == other.filePath && premultiplyAlpha == other.premultiplyAlpha;
+    }
+};
+
+/// <summary>
+/// A key used to uniquely identify a sprite sheet.
+/// </summary>
+struct SpriteSheetKey
+{
+    std::filesystem::path   filePath;
+    std::optional<uint32_t> spriteWidth;
+    std::optional<uint32_t> spriteHeight;
+    uint32_t                padding;
+    uint32_t                margin;
+    BlendMode               blendMode;
+
+    bool operator==( const SpriteSheetKey& other ) const
+    {
+        return filePath == other.filePath && spriteWidth == other.spriteWidth && spriteHeight == other.spriteHeight && padding == other.padding && margin == other.margin && blendMode == other.blendMode;
     }
 };
 
@@ -83,52 +122,247 @@ struct std::hash<FontKey>
         hash_combine( seed, key.size );
         hash_combine( seed, key.firstChar );
         hash_combine( seed, key.numChars );
+        hash_combine( seed, key.oversampling );
+        hash_combine( seed, key.glyphMode );
+
+        return seed;
+    }
+};
+
+// Hasher for an ImageKey.
+template<>
+struct std::hash<ImageKey>
+{
+    size_t operator()( const ImageKey& key ) const noexcept
+    {
+        std::size_t seed = 0;
+
+        hash_combine( seed, key.filePath );
+        hash_combine( seed, key.premultiplyAlpha );
+
+        return seed;
+    }
+};
+
+// Hasher for a SpriteSheetKey.
+template<>
+struct std::hash<SpriteSheetKey>
+{
+    size_t operator()( const SpriteSheetKey& key ) const noexcept
+    {
+        std::size_t seed = 0;
+
+        hash_combine( seed, key.filePath );
+        hash_combine( seed, key.spriteWidth );
+        hash_combine( seed, key.spriteHeight );
+        hash_combine( seed, key.padding );
+        hash_combine( seed, key.margin );
+        hash_combine( seed, key.blendMode.getPreset() );
 
         return seed;
     }
 };
 
 // Image store.
+// The images are stored as futures: an image is added to the store (under the lock) before it is decoded,
+// so that other threads that load the same image wait for it instead of decoding it again.
+using ImageFuture = std::shared_future<std::shared_ptr<Image>>;
 
 // Font store.
 static std::unordered_map<FontKey, std::shared_ptr<Font>> g_FontMap;
 
-std::unordered_map<std::filesystem::path, std::shared_ptr<Image>>& GetImageMap()
+// Glyph atlas store (one atlas per font file).
+static std::unordered_map<std::filesystem::path, std::shared_ptr<GlyphAtlas>> g_GlyphAtlasMap;
+
+// Guards the font and glyph atlas stores. Fonts are created under the lock since they add glyphs to the shared glyph atlas.
+static std::recursive_mutex g_FontMutex;
+
+// Sprite sheet store.
+static std::unordered_map<SpriteSheetKey, std::shared_ptr<SpriteSheet>> g_SpriteSheetMap;
+static std::mutex                                                       g_SpriteSheetMutex;
+
+std::unordered_map<ImageKey, ImageFuture>& GetImageMap()
 {
-    static std::unordered_map<std::filesystem::path, std::shared_ptr<Image>> g_ImageMap;
+    static std::unordered_map<ImageKey, ImageFuture> g_ImageMap;
     return g_ImageMap;
 }
 
-std::shared_ptr<Image> ResourceManager::loadImage( const std::filesystem::path& filePath )
+std::mutex& GetImageMutex()
+{
+    static std::mutex g_ImageMutex;
+    return g_ImageMutex;
+}
+
+// Get the path of the cooked version of an image.
+static std::filesystem::path cookedPath( const std::filesystem::path& filePath )
+{
+    return std::filesystem::path { filePath }.replace_extension( Image::CookedExtension );
+}
+
+// Load the cooked version of an image if it is up to date.
+// Returns an empty pointer if there is no (usable) cooked image, so that the source image is decoded instead.
+static std::shared_ptr<Image> loadCooked( const std::filesystem::path& filePath, bool premultiplyAlpha )
+{
+    const auto cooked = cookedPath( filePath );
+    if ( cooked == filePath )
+        return nullptr;
+
+    std::error_code ec;
+    const auto      cookedTime = std::filesystem::last_write_time( cooked, ec );
+    if ( ec )
+        return nullptr;
+
+    // Ignore cooked images that are older than the source image.
+    const auto sourceTime = std::filesystem::last_write_time( filePath, ec );
+    if ( !ec && cookedTime < sourceTime )
+        return nullptr;
+
+    auto image = std::make_shared<Image>( cooked );
+
+    // Premultiplied alpha can't be converted back to straight alpha without losing precision.
+    if ( !*image || ( image->isPremultiplied() && !premultiplyAlpha ) )
+        return nullptr;
+
+    return image;
+}
+
+// Check if an image has finished loading (without waiting for it).
+static bool isLoaded( const ImageFuture& image )
 {
-    const auto iter = GetImageMap().find( filePath );
+    return image.wait_for( std::chrono::seconds::zero() ) == std::future_status::ready;
+}
+
+std::shared_ptr<Image> ResourceManager::loadImage( const std::filesystem::path& filePath, bool premultiplyAlpha )
+{
+    ImageKey                             key { filePath, premultiplyAlpha };
+    std::promise<std::shared_ptr<Image>> promise;
+    ImageFuture                          cached;
 
-    if ( iter == GetImageMap().end() )
     {
-        auto image = std::make_shared<Image>( filePath );
+        std::lock_guard lock { GetImageMutex() };
+
+        auto [iter, inserted] = GetImageMap().try_emplace( key );
+        if ( inserted )
+            iter->second = promise.get_future().share();
+        else
+            cached = iter->second;
+    }
+
+    // The image is already loaded (or it is being loaded by another thread).
+    if ( cached.valid() )
+        return cached.get();
+
+    // Decode the image outside of the lock, so that different images can be decoded in parallel.
+    // A cooked image is used instead of the source image if it is up to date.
+    auto image = loadCooked( filePath, premultiplyAlpha );
+    if ( !image )
+        image = std::make_shared<Image>( filePath );
+
+    if ( premultiplyAlpha && !image->isPremultiplied() )
+        image->premultiplyAlpha();
 
-        GetImageMap()[filePath] = image;
+    promise.set_value( image );
 
-        return image;
+    return image;
+}
+
+std::shared_future<std::shared_ptr<Image>> ResourceManager::loadImageAsync( const std::filesystem::path& filePath, bool premultiplyAlpha )
+{
+    {
+        std::lock_guard lock { GetImageMutex() };
+
+        const auto iter = GetImageMap().find( ImageKey { filePath, premultiplyAlpha } );
+        if ( iter != GetImageMap().end() )
+            return iter->second;
     }
 
-    return iter->second;
+    return std::async( std::launch::async, [filePath, premultiplyAlpha] { return loadImage( filePath, premultiplyAlpha ); } ).share();
+}
+
+void ResourceManager::preload( std::span<const std::filesystem::path> filePaths, bool premultiplyAlpha )
+{
+#pragma omp parallel for schedule( dynamic )
+    for ( int i = 0; i < static_cast<int>( filePaths.size() ); ++i )
+        loadImage( filePaths[i], premultiplyAlpha );
+}
+
+void ResourceManager::cookImages( std::span<const std::filesystem::path> filePaths, bool premultiplyAlpha )
+{
+#pragma omp parallel for schedule( dynamic )
+    for ( int i = 0; i < static_cast<int>( filePaths.size() ); ++i )
+    {
+        Image image { filePaths[i] };
+        if ( !image )
+            continue;
+
+        if ( premultiplyAlpha )
+            image.premultiplyAlpha();
+
+        image.save( cookedPath( filePaths[i] ) );
+    }
 }
 
 std::shared_ptr<SpriteSheet> ResourceManager::loadSpriteSheet( const std::filesystem::path& filePath, std::optional<uint32_t> spriteWidth, std::optional<uint32_t> spriteHeight, uint32_t padding, uint32_t margin, const BlendMode& blendMode )
 {
-    auto image = loadImage( filePath );
-    return std::make_shared<SpriteSheet>( image, spriteWidth, spriteHeight, padding, margin, blendMode );
+    SpriteSheetKey key { filePath, spriteWidth, spriteHeight, padding, margin, blendMode };
+
+    {
+        std::lock_guard lock { g_SpriteSheetMutex };
+
+        const auto iter = g_SpriteSheetMap.find( key );
+        if ( iter != g_SpriteSheetMap.end() )
+            return iter->second;
+    }
+
+    auto image       = loadImage( filePath, blendMode.getPreset() == BlendPreset::PremultipliedAlpha );
+    auto spriteSheet = std::make_shared<SpriteSheet>( image, spriteWidth, spriteHeight, padding, margin, blendMode );
+
+    // If another thread created the same sprite sheet in the meantime, use that one.
+    std::lock_guard lock { g_SpriteSheetMutex };
+    return g_SpriteSheetMap.try_emplace( key, std::move( spriteSheet ) ).first->second;
 }
 
-std::shared_ptr<Font> ResourceManager::loadFont( const std::filesystem::path& fontFile, float size, uint32_t firstChar, uint32_t numChars )
+std::shared_ptr<TextureAtlas> ResourceManager::packSpriteSheets( uint32_t pageSize )
 {
-    FontKey    key { fontFile, size, firstChar, numChars };
+    std::vector<std::shared_ptr<SpriteSheet>> spriteSheets;
+    {
+        std::lock_guard lock { g_SpriteSheetMutex };
+
+        spriteSheets.reserve( g_SpriteSheetMap.size() );
+        for ( const auto& [key, spriteSheet]: g_SpriteSheetMap )
+            spriteSheets.push_back( spriteSheet );
+    }
+
+    std::lock_guard lock { GetImageMutex() };
+
+    // The images that are used (by the sprite sheets or elsewhere) before packing.
+    // Images that are preloaded but not used yet are not unloaded.
+    std::unordered_set<const Image*> usedImages;
+    for ( const auto& [key, image]: GetImageMap() )
+    {
+        if ( isLoaded( image ) && image.get().use_count() > 1 )
+            usedImages.insert( image.get().get() );
+    }
+
+    auto atlas = std::make_shared<TextureAtlas>( pageSize );
+    atlas->pack( spriteSheets );
+
+    // Unload the images that are not used anymore.
+    std::erase_if( GetImageMap(), [&]( const auto& item ) { return isLoaded( item.second ) && item.second.get().use_count() == 1 && usedImages.contains( item.second.get().get() ); } );
+
+    return atlas;
+}
+
+std::shared_ptr<Font> ResourceManager::loadFont( const std::filesystem::path& fontFile, float size, uint32_t firstChar, uint32_t numChars, uint32_t oversampling, GlyphMode glyphMode )
+{
+    std::lock_guard lock { g_FontMutex };
+
+    FontKey    key { fontFile, size, firstChar, numChars, oversampling, glyphMode };
     const auto iter = g_FontMap.find( key );
 
     if ( iter == g_FontMap.end() )
     {
-        auto font = std::make_shared<Font>( fontFile, size, firstChar, numChars );
+        auto font = std::make_shared<Font>( loadGlyphAtlas( fontFile ), size, firstChar, numChars, oversampling, glyphMode );
 
         g_FontMap[key] = font;
 
@@ -138,8 +372,37 @@ std::shared_ptr<Font> ResourceManager::loadFont( const std::filesystem::path& fo
     return iter->second;
 }
 
+std::shared_ptr<GlyphAtlas> ResourceManager::loadGlyphAtlas( const std::filesystem::path& fontFile )
+{
+    std::lock_guard lock { g_FontMutex };
+
+    const auto iter = g_GlyphAtlasMap.find( fontFile );
+
+    if ( iter == g_GlyphAtlasMap.end() )
+    {
+        auto glyphAtlas = std::make_shared<GlyphAtlas>( fontFile );
+
+        g_GlyphAtlasMap[fontFile] = glyphAtlas;
+
+        return glyphAtlas;
+    }
+
+    return iter->second;
+}
+
 void ResourceManager::clear()
 {
-    GetImageMap().clear();
-    g_FontMap.clear();
+    {
+        std::lock_guard lock { GetImageMutex() };
+        GetImageMap().clear();
+    }
+    {
+        std::lock_guard lock { g_FontMutex };
+        g_FontMap.clear();
+        g_GlyphAtlasMap.clear();
+    }
+    {
+        std::lock_guard lock { g_SpriteSheetMutex };
+        g_SpriteSheetMap.clear();
+    }
 }
@@ -1,6 +1,8 @@
 #include <Graphics/ResourceManager.hpp>
 #include <Graphics/SpriteSheet.hpp>
 
+#include <algorithm>
+
 using namespace Graphics;
 
 /// <summary>
@@ -29,8 +31,45 @@ constexpr uint32_t getSpriteSize( uint32_t imageSize, uint32_t numSprites, uint3
     return ( imageSize - 2 * margin - ( numSprites - 1 ) * padding ) / numSprites;
 }
 
+/// <summary>
+/// Helper function to compute the bounding rectangle of the pixels in a region of an image that are not fully transparent.
+/// </summary>
+/// <param name="image">The image that contains the sprite.</param>
+/// <param name="rect">The source rectangle of the sprite in the image.</param>
+/// <returns>The bounding rectangle of the visible pixels (with a width and height of 0 if all pixels are transparent).</returns>
+static Math::RectI getAlphaBounds( const Image& image, const Math::RectI& rect )
+{
+    const int left   = std::max( rect.left, 0 );
+    const int top    = std::max( rect.top, 0 );
+    const int right  = std::min( rect.left + rect.width, static_cast<int>( image.getWidth() ) );
+    const int bottom = std::min( rect.top + rect.height, static_cast<int>( image.getHeight() ) );
+
+    int minX = right, minY = bottom, maxX = left - 1, maxY = top - 1;
+
+    for ( int y = top; y < bottom; ++y )
+    {
+        const Color* row = image.data() + static_cast<size_t>( y ) * image.getWidth();
+
+        for ( int x = left; x < right; ++x )
+        {
+            if ( row[x].a != 0 )
+            {
+                minX = std::min( minX, x );
+                maxX = std::max( maxX, x );
+                minY = std::min( minY, y );
+                maxY = y;
+            }
+        }
+    }
+
+    if ( maxX < minX )
+        return { rect.left, rect.top, 0, 0 };
+
+    return { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+}
+
 SpriteSheet::SpriteSheet( const std::filesystem::path& fileName, std::optional<uint32_t> spriteWidth, std::optional<uint32_t> spriteHeight, uint32_t padding, uint32_t margin, const BlendMode& blendMode )
-: image { ResourceManager::loadImage( fileName ) }
+: image { ResourceManager::loadImage( fileName, blendMode.getPreset() == BlendPreset::PremultipliedAlpha ) }
 , blendMode { blendMode }
 , padding { padding }
 , margin { margin }
@@ -52,7 +91,7 @@ SpriteSheet::SpriteSheet( const std::filesystem::path& fileName, std::optional<u
 }
 
 SpriteSheet::SpriteSheet( const std::filesystem::path& fileName, std::span<const Math::RectI> rects, const BlendMode& blendMode )
-: image { ResourceManager::loadImage( fileName ) }
+: image { ResourceManager::loadImage( fileName, blendMode.getPreset() == BlendPreset::PremultipliedAlpha ) }
 , blendMode { blendMode }
 , spriteRects { rects.begin(), rects.end() }
 , columns { static_cast<uint32_t>( rects.size() ) }
@@ -87,25 +126,25 @@ SpriteSheet::SpriteSheet( const SpriteSheet& copy )
 : image { copy.image }
 , blendMode { copy.blendMode }
 , spriteRects { copy.spriteRects }
+, visibleRegions { copy.visibleRegions }
 , columns { copy.columns }
 , rows { copy.rows }
 , padding { copy.padding }
 , margin { copy.margin }
-{
-    initSprites();
-}
+, sprites { copy.sprites }
+{}
 
 SpriteSheet::SpriteSheet( SpriteSheet&& other ) noexcept
 : image { std::move( other.image ) }
 , blendMode { other.blendMode }
 , spriteRects { std::move( other.spriteRects ) }
+, visibleRegions { std::move( other.visibleRegions ) }
 , columns { other.columns }
 , rows { other.rows }
 , padding { other.padding }
 , margin { other.margin }
+, sprites { std::move( other.sprites ) }
 {
-    initSprites();
-
     other.rows    = 0u;
     other.columns = 0u;
     other.sprites.clear();
@@ -116,15 +155,15 @@ SpriteSheet& SpriteSheet::operator=( const SpriteSheet& copy )
     if ( &copy == this )
         return *this;
 
-    image       = copy.image;
-    blendMode   = copy.blendMode;
-    spriteRects = copy.spriteRects;
-    columns     = copy.columns;
-    rows        = copy.rows;
-    padding     = copy.padding;
-    margin      = copy.margin;
-
-    initSprites();
+    image          = copy.image;
+    blendMode      = copy.blendMode;
+    spriteRects    = copy.spriteRects;
+    visibleRegions = copy.visibleRegions;
+    columns        = copy.columns;
+    rows           = copy.rows;
+    padding        = copy.padding;
+    margin         = copy.margin;
+    sprites        = copy.sprites;
 
     return *this;
 }
@@ -134,15 +173,15 @@ SpriteSheet& SpriteSheet::operator=( SpriteSheet&& other ) noexcept
     if ( &other == this )
         return *this;
 
-    image       = std::move( other.image );
-    blendMode   = other.blendMode;
-    spriteRects = std::move( other.spriteRects );
-    columns     = other.columns;
-    rows        = other.rows;
-    padding     = other.padding;
-    margin      = other.margin;
-
-    initSprites();
+    image          = std::move( other.image );
+    blendMode      = other.blendMode;
+    spriteRects    = std::move( other.spriteRects );
+    visibleRegions = std::move( other.visibleRegions );
+    columns        = other.columns;
+    rows           = other.rows;
+    padding        = other.padding;
+    margin         = other.margin;
+    sprites        = std::move( other.sprites );
 
     other.columns = 0u;
     other.rows    = 0u;
@@ -174,7 +213,7 @@ const Sprite& SpriteSheet::operator()( size_t i, size_t j ) const noexcept
 
 std::shared_ptr<SpriteSheet> SpriteSheet::fromGrid( const std::filesystem::path& fileName, uint32_t columns, uint32_t rows, uint32_t padding, uint32_t margin, const BlendMode& blendMode )
 {
-    std::shared_ptr<Image> image = ResourceManager::loadImage( fileName );
+    std::shared_ptr<Image> image = ResourceManager::loadImage( fileName, blendMode.getPreset() == BlendPreset::PremultipliedAlpha );
 
     if ( !image )
         return nullptr;
@@ -216,8 +255,32 @@ void SpriteSheet::initSprites()
     if ( !image )
         return;
 
-    for ( const auto& rect: spriteRects )
+    // Compute the visible regions the first time the sprites are created.
+    if ( !visibleRegions || visibleRegions->size() != spriteRects.size() )
     {
-        sprites.emplace_back( image, rect, blendMode );
+        // Fully transparent pixels don't change the destination if the sprites are alpha blended,
+        // so the sprites can be trimmed to their visible pixels.
+        const bool trim = Sprite::canTrim( blendMode, *image );
+
+        auto regions = std::make_shared<std::vector<VisibleRegion>>( spriteRects.size() );
+
+#pragma omp parallel for
+        for ( int i = 0; i < static_cast<int>( spriteRects.size() ); ++i )
+        {
+            VisibleRegion& region = ( *regions )[i];
+
+            region.rect  = trim ? ::getAlphaBounds( *image, spriteRects[i] ) : spriteRects[i];
+            region.spans = SpriteSpans { *image, region.rect };
+        }
+
+        visibleRegions = std::move( regions );
+    }
+
+    for ( size_t i = 0; i < spriteRects.size(); ++i )
+    {
+        const VisibleRegion& region = ( *visibleRegions )[i];
+
+        // The sprite shares ownership of all visible regions of the sprite sheet.
+        sprites.emplace_back( image, spriteRects[i], blendMode, std::shared_ptr<const SpriteSpans> { visibleRegions, &region.spans }, region.rect );
     }
 }
@@ -0,0 +1,56 @@
+#include <Graphics/Image.hpp>
+#include <Graphics/SpriteSpans.hpp>
+
+#include <algorithm>
+
+using namespace Graphics;
+
+SpriteSpans::SpriteSpans( const Image& image, const Math::RectI& rect )
+{
+    // Clamp the sprite rectangle to the image.
+    const int left   = std::max( rect.left, 0 );
+    const int top    = std::max( rect.top, 0 );
+    const int right  = std::min( rect.left + rect.width, static_cast<int>( image.getWidth() ) );
+    const int bottom = std::min( rect.top + rect.height, static_cast<int>( image.getHeight() ) );
+
+    rows.reserve( static_cast<size_t>( std::max( rect.height, 0 ) ) + 1 );
+
+    for ( int y = rect.top; y < rect.top + rect.height; ++y )
+    {
+        if ( y >= top && y < bottom )
+        {
+            const Color* row = image.data() + static_cast<size_t>( y ) * image.getWidth();
+
+            int x = left;
+            while ( x < right )
+            {
+                const uint8_t a = row[x].a;
+
+                // Find the end of the run of pixels with the same type.
+                int end = x + 1;
+                if ( a == 0 )
+                {
+                    while ( end < right && row[end].a == 0 )
+                        ++end;
+                }
+                else if ( a == 255 )
+                {
+                    while ( end < right && row[end].a == 255 )
+                        ++end;
+                }
+                else
+                {
+                    while ( end < right && row[end].a != 0 && row[end].a != 255 )
+                        ++end;
+                }
+
+                if ( a != 0 )
+                    runs.push_back( { static_cast<uint32_t>( x - rect.left ), static_cast<uint32_t>( end - x ), a == 255 } );
+
+                x = end;
+            }
+        }
+
+        rows.push_back( static_cast<uint32_t>( runs.size() ) );
+    }
+}
@@ -0,0 +1,78 @@
+#include "TextCache.hpp"
+
+#include <algorithm>
+#include <functional>  // std::hash
+
+using namespace Graphics;
+
+TextCache::TextCache( size_t capacity )
+: m_capacity { capacity }
+{}
+
+TextRun* TextCache::find( std::string_view text )
+{
+    const auto iter = m_map.find( text );
+    if ( iter == m_map.end() )
+        return nullptr;
+
+    // Move the run to the front of the list.
+    m_runs.splice( m_runs.begin(), m_runs, iter->second );
+
+    return &iter->second->second;
+}
+
+TextRun& TextCache::insert( std::string text, TextRun run )
+{
+    if ( TextRun* cached = find( text ) )
+    {
+        *cached = std::move( run );
+        return *cached;
+    }
+
+    // Evict the least recently used runs.
+    while ( !m_runs.empty() && m_runs.size() >= m_capacity )
+    {
+        m_map.erase( m_runs.back().first );
+        m_runs.pop_back();
+    }
+
+    m_runs.emplace_front( std::move( text ), std::move( run ) );
+    m_map.emplace( m_runs.front().first, m_runs.begin() );
+
+    return m_runs.front().second;
+}
+
+bool TextCache::admit( std::string_view text ) noexcept
+{
+    // Zero marks an unused slot.
+    const size_t hash = std::max<size_t>( std::hash<std::string_view> {}( text ), 1u );
+
+    if ( std::find( m_seen.begin(), m_seen.end(), hash ) != m_seen.end() )
+        return true;
+
+    m_seen[m_nextSeen] = hash;
+    m_nextSeen         = ( m_nextSeen + 1 ) % m_seen.size();
+
+    return false;
+}
+
+const Math::RectF* TextCache::findBounds( std::string_view text ) const noexcept
+{
+    const size_t  hash  = std::max<size_t>( std::hash<std::string_view> {}( text ), 1u );
+    const Bounds& entry = m_bounds[hash % m_bounds.size()];
+
+    if ( entry.hash != hash || entry.text != text )
+        return nullptr;
+
+    return &entry.bounds;
+}
+
+void TextCache::insertBounds( std::string_view text, const Math::RectF& bounds )
+{
+    const size_t hash  = std::max<size_t>( std::hash<std::string_view> {}( text ), 1u );
+    Bounds&      entry = m_bounds[hash % m_bounds.size()];
+
+    entry.hash = hash;
+    entry.text.assign( text );
+    entry.bounds = bounds;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <Graphics/AlphaImage.hpp>
+
+#include <Math/Rect.hpp>
+
+#include <glm/vec2.hpp>
+
+#include <array>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace Graphics
+{
+
+/// <summary>
+/// A string of text that is rasterized once into a coverage mask.
+/// The mask only stores the coverage of the glyphs, so the run can be drawn in any color.
+/// </summary>
+struct TextRun
+{
+    /// <summary>
+    /// The mask of the text (null if the text has no visible glyphs).
+    /// </summary>
+    std::shared_ptr<const AlphaImage> mask;
+
+    /// <summary>
+    /// The position of the top-left corner of the mask relative to the text position.
+    /// </summary>
+    glm::ivec2 offset { 0 };
+
+    /// <summary>
+    /// The mask dilated by one pixel, used to draw an outline around the text.
+    /// Only created when the text is drawn with an outline (one pixel up and to the left of the offset).
+    /// </summary>
+    std::shared_ptr<const AlphaImage> outline;
+};
+
+/// <summary>
+/// A least recently used cache of text runs, and a cache of the bounds of recently measured text.
+/// The cache is not thread safe: text should only be drawn from a single thread.
+/// </summary>
+class TextCache final
+{
+public:
+    /// <summary>
+    /// The default number of text runs that are kept in the cache.
+    /// </summary>
+    static constexpr size_t DefaultCapacity = 64u;
+
+    explicit TextCache( size_t capacity = DefaultCapacity );
+
+    /// <summary>
+    /// Find the run of a text and mark it as the most recently used run.
+    /// </summary>
+    /// <param name="text">The (UTF-8) text to find.</param>
+    /// <returns>A pointer to the run, or nullptr if the text is not in the cache.</returns>
+    TextRun* find( std::string_view text );
+
+    /// <summary>
+    /// Add the run of a text to the cache. The least recently used run is evicted if the cache is full.
+    /// </summary>
+    /// <param name="text">The (UTF-8) text of the run.</param>
+    /// <param name="run">The rasterized text.</param>
+    /// <returns>The cached run.</returns>
+    TextRun& insert( std::string text, TextRun run );
+
+    /// <summary>
+    /// Check if a text that is not in the cache should be added to the cache.
+    /// Text is only worth caching if it is drawn more than once, so the first time a text is seen
+    /// it is only remembered (by its hash) and this function returns false.
+    /// </summary>
+    /// <param name="text">The (UTF-8) text that is not in the cache.</param>
+    /// <returns>`true` if the text was seen recently, `false` otherwise.</returns>
+    bool admit( std::string_view text ) noexcept;
+
+    /// <summary>
+    /// Find the measured bounds of a text.
+    /// </summary>
+    /// <param name="text">The (UTF-8) text to find.</param>
+    /// <returns>A pointer to the bounds, or nullptr if the text was not measured recently.</returns>
+    const Math::RectF* findBounds( std::string_view text ) const noexcept;
+
+    /// <summary>
+    /// Store the measured bounds of a text. The bounds replace the bounds of a text with the same slot in the cache.
+    /// Each slot keeps its string, so once the slots are filled storing bounds doesn't allocate (unless the text is longer than the previous text in the slot).
+    /// </summary>
+    /// <param name="text">The (UTF-8) text that was measured.</param>
+    /// <param name="bounds">The bounds of the text.</param>
+    void insertBounds( std::string_view text, const Math::RectF& bounds );
+
+    /// <summary>
+    /// Get the number of runs in the cache.
+    /// </summary>
+    size_t size() const noexcept
+    {
+        return m_runs.size();
+    }
+
+private:
+    using List = std::list<std::pair<std::string, TextRun>>;
+
+    size_t m_capacity;
+    // The cached runs, ordered from most to least recently used.
+    List m_runs;
+    // Maps the text of each run to its node in the list.
+    // The keys refer to the strings in the list nodes (which never move).
+    std::unordered_map<std::string_view, List::iterator> m_map;
+
+    // The hashes of the texts that were recently seen but not cached (a ring buffer).
+    std::array<size_t, DefaultCapacity> m_seen {};
+    size_t                              m_nextSeen = 0u;
+
+    // The measured bounds of a text.
+    struct Bounds
+    {
+        size_t      hash = 0u;
+        std::string text;
+        Math::RectF bounds;
+    };
+
+    // The bounds of recently measured text (a direct mapped cache, indexed by the hash of the text).
+    std::array<Bounds, DefaultCapacity> m_bounds {};
+};
+
+}  // namespace Graphics
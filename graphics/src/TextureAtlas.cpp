@@ -0,0 +1,265 @@
+#include <Graphics/TextureAtlas.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>  // std::hash
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+using namespace Graphics;
+using namespace Math;
+
+namespace
+{
+// Values in the sprite to frame mapping for sprites that are not packed.
+constexpr int NoFrame    = -1;
+constexpr int EmptyFrame = -2;
+
+// The pixels of a frame that are stored in the atlas.
+struct Frame
+{
+    const Image* image;
+    RectI        rect;
+    bool         premultiplied;
+    size_t       hash;
+
+    // The placement of the frame in the atlas.
+    size_t page = 0;
+    int    x    = 0;
+    int    y    = 0;
+};
+
+// The size of a page in the atlas.
+struct PageLayout
+{
+    uint32_t width;
+    uint32_t height;
+    bool     premultiplied;
+};
+
+const Color* row( const Image& image, const RectI& rect, int y ) noexcept
+{
+    return image.data() + static_cast<size_t>( rect.top + y ) * image.getWidth() + rect.left;
+}
+
+// Compute a hash of the size and the pixels of a frame.
+size_t hashFrame( const Image& image, const RectI& rect ) noexcept
+{
+    size_t seed = std::hash<int> {}( rect.width ) ^ ( std::hash<int> {}( rect.height ) << 1 );
+
+    for ( int y = 0; y < rect.height; ++y )
+    {
+        const std::string_view pixels { reinterpret_cast<const char*>( row( image, rect, y ) ), rect.width * sizeof( Color ) };
+        seed ^= std::hash<std::string_view> {}( pixels ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+    }
+
+    return seed;
+}
+
+// Check if two frames have exactly the same pixels.
+bool equalFrames( const Frame& a, const Frame& b ) noexcept
+{
+    if ( a.rect.width != b.rect.width || a.rect.height != b.rect.height || a.premultiplied != b.premultiplied )
+        return false;
+
+    for ( int y = 0; y < a.rect.height; ++y )
+    {
+        if ( std::memcmp( row( *a.image, a.rect, y ), row( *b.image, b.rect, y ), a.rect.width * sizeof( Color ) ) != 0 )
+            return false;
+    }
+
+    return true;
+}
+}  // namespace
+
+TextureAtlas::TextureAtlas( uint32_t pageSize )
+: pageSize { pageSize }
+{}
+
+std::vector<Sprite> TextureAtlas::pack( std::span<const Sprite> sprites )
+{
+    std::vector<Sprite> result { sprites.begin(), sprites.end() };
+
+    // Find the unique frames.
+    std::vector<Frame>                      frames;
+    std::vector<int>                        spriteFrames( sprites.size(), NoFrame );
+    std::unordered_multimap<size_t, size_t> frameMap;
+
+    for ( size_t i = 0; i < sprites.size(); ++i )
+    {
+        const Sprite& sprite = sprites[i];
+        if ( !sprite )
+            continue;
+
+        const Image& image = *sprite.getImage();
+        const RectI& rect  = sprite.getTrimRect();
+
+        // Fully transparent sprites don't have any pixels to pack.
+        if ( rect.width <= 0 || rect.height <= 0 )
+        {
+            spriteFrames[i] = EmptyFrame;
+            continue;
+        }
+
+        // Sprites that are not inside their image are not packed.
+        if ( rect.left < 0 || rect.top < 0 || rect.right() > static_cast<int>( image.getWidth() ) || rect.bottom() > static_cast<int>( image.getHeight() ) )
+            continue;
+
+        Frame frame { &image, rect, image.isPremultiplied(), hashFrame( image, rect ) };
+
+        // Check if the same frame was already added.
+        auto [begin, end] = frameMap.equal_range( frame.hash );
+        auto iter         = std::find_if( begin, end, [&]( const auto& f ) { return equalFrames( frames[f.second], frame ); } );
+
+        if ( iter != end )
+        {
+            spriteFrames[i] = static_cast<int>( iter->second );
+        }
+        else
+        {
+            spriteFrames[i] = static_cast<int>( frames.size() );
+            frameMap.emplace( frame.hash, frames.size() );
+            frames.push_back( frame );
+        }
+
+        ++numFrames;
+    }
+
+    numUniqueFrames += frames.size();
+
+    if ( frames.empty() )
+        return result;
+
+    // Pack the tallest frames first. Premultiplied and straight alpha frames are stored on separate pages.
+    std::vector<size_t> order( frames.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(), [&]( size_t a, size_t b ) {
+        const Frame& fa = frames[a];
+        const Frame& fb = frames[b];
+        if ( fa.premultiplied != fb.premultiplied )
+            return fa.premultiplied < fb.premultiplied;
+        if ( fa.rect.height != fb.rect.height )
+            return fa.rect.height > fb.rect.height;
+        return fa.rect.width > fb.rect.width;
+    } );
+
+    // Place the frames on shelves (rows of frames) from top to bottom.
+    std::vector<PageLayout> layouts;
+    size_t                  page   = 0;
+    int                     x      = 0;
+    int                     y      = 0;
+    int                     shelfH = 0;
+
+    const int size = static_cast<int>( pageSize );
+
+    for ( const size_t i: order )
+    {
+        Frame&    frame = frames[i];
+        const int w     = frame.rect.width;
+        const int h     = frame.rect.height;
+
+        // Frames that don't fit on a page get their own page.
+        if ( w > size || h > size )
+        {
+            frame.page = layouts.size();
+            layouts.push_back( { static_cast<uint32_t>( w ), static_cast<uint32_t>( h ), frame.premultiplied } );
+            continue;
+        }
+
+        // Start a new shelf if the frame doesn't fit on the current shelf.
+        if ( x + w > size )
+        {
+            x = 0;
+            y += shelfH;
+            shelfH = 0;
+        }
+
+        // Start a new page if the frame doesn't fit on the current page.
+        if ( layouts.empty() || layouts[page].width != pageSize || layouts[page].premultiplied != frame.premultiplied || y + h > size )
+        {
+            page = layouts.size();
+            layouts.push_back( { pageSize, 0u, frame.premultiplied } );
+            x      = 0;
+            y      = 0;
+            shelfH = 0;
+        }
+
+        frame.page = page;
+        frame.x    = x;
+        frame.y    = y;
+
+        x += ( w + static_cast<int>( Alignment ) - 1 ) / static_cast<int>( Alignment ) * static_cast<int>( Alignment );
+        shelfH = std::max( shelfH, h );
+
+        layouts[page].height = std::max( layouts[page].height, static_cast<uint32_t>( y + h ) );
+    }
+
+    // Allocate the pages (only as tall as needed).
+    const size_t firstPage = pages.size();
+    for ( const PageLayout& layout: layouts )
+    {
+        auto image = std::make_shared<Image>( layout.width, layout.height );
+        image->clear( Color { 0, 0, 0, 0 } );
+        image->m_premultiplied = layout.premultiplied;
+        pages.push_back( std::move( image ) );
+    }
+
+    // Copy the frames to the pages.
+#pragma omp parallel for
+    for ( int i = 0; i < static_cast<int>( frames.size() ); ++i )
+    {
+        const Frame& frame = frames[i];
+        Image&       dst   = *pages[firstPage + frame.page];
+
+        for ( int j = 0; j < frame.rect.height; ++j )
+        {
+            std::memcpy( dst.m_data.get() + static_cast<size_t>( frame.y + j ) * dst.m_width + frame.x, row( *frame.image, frame.rect, j ), frame.rect.width * sizeof( Color ) );
+        }
+    }
+
+    // Point the sprites to the pages.
+    for ( size_t i = 0; i < result.size(); ++i )
+    {
+        if ( spriteFrames[i] == EmptyFrame )
+        {
+            // Empty sprites don't sample any pixels, but they shouldn't keep the original image alive.
+            result[i].setImage( pages[firstPage], { 0, 0 } );
+        }
+        else if ( spriteFrames[i] != NoFrame )
+        {
+            const Frame& frame = frames[spriteFrames[i]];
+            result[i].setImage( pages[firstPage + frame.page], { frame.x, frame.y } );
+        }
+    }
+
+    return result;
+}
+
+void TextureAtlas::pack( std::span<const std::shared_ptr<SpriteSheet>> spriteSheets )
+{
+    // Pack the sprites of all sprite sheets together.
+    std::vector<Sprite> sprites;
+    for ( const auto& spriteSheet: spriteSheets )
+    {
+        if ( spriteSheet )
+            sprites.insert( sprites.end(), spriteSheet->sprites.begin(), spriteSheet->sprites.end() );
+    }
+
+    const std::vector<Sprite> packed = pack( sprites );
+
+    auto iter = packed.begin();
+    for ( const auto& spriteSheet: spriteSheets )
+    {
+        if ( !spriteSheet )
+            continue;
+
+        for ( Sprite& sprite: spriteSheet->sprites )
+        {
+            sprite = *iter++;
+        }
+
+        // The sprites don't refer to the original image anymore.
+        spriteSheet->image.reset();
+    }
+}
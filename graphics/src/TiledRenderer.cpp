@@ -0,0 +1,246 @@
+#include "TiledRenderer.hpp"
+
+#include <algorithm>
+
+using namespace Graphics;
+using namespace Math;
+
+// Helper to build a visitor from a set of lambdas.
+template<typename... Ts>
+struct overloaded : Ts...
+{
+    using Ts::operator()...;
+};
+
+void TiledRenderer::record( Command command )
+{
+    m_commands.emplace_back( std::move( command ) );
+}
+
+void TiledRenderer::flush( Image& image )
+{
+    m_numDirtyTiles = 0;
+
+    if ( m_commands.empty() )
+        return;
+
+    const int width  = static_cast<int>( image.getWidth() );
+    const int height = static_cast<int>( image.getHeight() );
+
+    const int tilesX   = ( width + TileSize - 1 ) / TileSize;
+    const int tilesY   = ( height + TileSize - 1 ) / TileSize;
+    const int numTiles = tilesX * tilesY;
+
+    if ( m_tiles.size() < static_cast<size_t>( numTiles ) )
+        m_tiles.resize( numTiles );
+    if ( m_dirtyTracking && m_prevTiles.size() < static_cast<size_t>( numTiles ) )
+        m_prevTiles.resize( numTiles );
+
+    // Bin the commands into the tiles they overlap.
+    for ( uint32_t i = 0; i < static_cast<uint32_t>( m_commands.size() ); ++i )
+    {
+        AABB aabb = bounds( m_commands[i], image );
+
+        if ( !image.m_AABB.intersect( aabb ) )
+            continue;
+
+        aabb.clamp( image.m_AABB );
+
+        const int tx0 = static_cast<int>( aabb.min.x ) / TileSize;
+        const int ty0 = static_cast<int>( aabb.min.y ) / TileSize;
+        const int tx1 = static_cast<int>( aabb.max.x ) / TileSize;
+        const int ty1 = static_cast<int>( aabb.max.y ) / TileSize;
+
+        for ( int ty = ty0; ty <= ty1; ++ty )
+        {
+            for ( int tx = tx0; tx <= tx1; ++tx )
+            {
+                m_tiles[static_cast<size_t>( ty ) * tilesX + tx].push_back( i );
+            }
+        }
+    }
+
+    // With dirty tracking, the previous commands are only valid if the image wasn't resized.
+    const bool retain = m_dirtyTracking && m_prevWidth == width && m_prevHeight == height;
+
+    size_t numDirtyTiles = 0;
+
+    // Rasterize each tile on its own thread.
+#pragma omp parallel for schedule( dynamic ) reduction( + : numDirtyTiles )
+    for ( int t = 0; t < numTiles; ++t )
+    {
+        std::vector<uint32_t>& tile = m_tiles[t];
+        if ( tile.empty() )
+            continue;
+
+        // The tile still contains the pixels of the previous flush if the same commands overlap it.
+        if ( retain && isClean( tile, m_prevTiles[t] ) )
+            continue;
+
+        const int x = ( t % tilesX ) * TileSize;
+        const int y = ( t / tilesX ) * TileSize;
+
+        const AABB clip {
+            { x, y, 0 },
+            { std::min( x + TileSize, width ) - 1, std::min( y + TileSize, height ) - 1, 0 }
+        };
+
+        for ( const uint32_t i: tile )
+        {
+            execute( image, m_commands[i], clip );
+        }
+
+        ++numDirtyTiles;
+    }
+
+    m_numDirtyTiles = numDirtyTiles;
+
+    if ( m_dirtyTracking )
+    {
+        // Keep the commands of this flush to compare against the next flush.
+        std::swap( m_commands, m_prevCommands );
+        std::swap( m_tiles, m_prevTiles );
+        m_prevWidth  = width;
+        m_prevHeight = height;
+    }
+
+    for ( auto& tile: m_tiles )
+        tile.clear();
+
+    m_commands.clear();
+}
+
+void TiledRenderer::setDirtyTracking( bool enable )
+{
+    m_dirtyTracking = enable;
+    invalidate();
+}
+
+void TiledRenderer::invalidate() noexcept
+{
+    m_prevCommands.clear();
+    m_prevWidth  = 0;
+    m_prevHeight = 0;
+}
+
+bool TiledRenderer::isClean( const std::vector<uint32_t>& tile, const std::vector<uint32_t>& prevTile ) const noexcept
+{
+    if ( tile.size() != prevTile.size() )
+        return false;
+
+    for ( size_t i = 0; i < tile.size(); ++i )
+    {
+        if ( m_commands[tile[i]] != m_prevCommands[prevTile[i]] )
+            return false;
+    }
+
+    return true;
+}
+
+AABB TiledRenderer::bounds( const Command& command, const Image& image ) noexcept
+{
+    return std::visit(
+        overloaded {
+            [&]( const ClearCommand& ) {
+                return image.m_AABB;
+            },
+            []( const CopyCommand& cmd ) {
+                return AABB::fromRect( RectI { cmd.x, cmd.y, static_cast<int>( cmd.image->getWidth() ) - 1, static_cast<int>( cmd.image->getHeight() ) - 1 } );
+            },
+            []( const ScaledCopyCommand& cmd ) {
+                return cmd.dstAABB;
+            },
+            []( const LineCommand& cmd ) {
+                return AABB { { cmd.x0, cmd.y0, 0 }, { cmd.x1, cmd.y1, 0 } };
+            },
+            []( const TriangleCommand& cmd ) {
+                return AABB::fromTriangle( { cmd.p0, 0 }, { cmd.p1, 0 }, { cmd.p2, 0 } );
+            },
+            []( const QuadCommand& cmd ) {
+                return AABB::fromQuad( { cmd.p0, 0 }, { cmd.p1, 0 }, { cmd.p2, 0 }, { cmd.p3, 0 } );
+            },
+            []( const TexturedQuadCommand& cmd ) {
+                return AABB::fromQuad( { cmd.v0.position, 0 }, { cmd.v1.position, 0 }, { cmd.v2.position, 0 }, { cmd.v3.position, 0 } );
+            },
+            []( const AABBCommand& cmd ) {
+                return cmd.aabb;
+            },
+            []( const EllipseCommand& cmd ) {
+                return AABB::fromMinMax( { cmd.center - cmd.radii, 0 }, { cmd.center + cmd.radii, 0 } );
+            },
+            []( const SpriteCommand& cmd ) {
+                // Only the trimmed rectangle of the sprite is drawn (with the same matrix that is used to rasterize it).
+                const glm::mat3 matrix = Image::trimmedSpriteMatrix( cmd.sprite, cmd.matrix );
+                const glm::vec2 size { cmd.sprite.getTrimRect().width, cmd.sprite.getTrimRect().height };
+                const glm::vec2 p0 = matrix * glm::vec3 { 0, 0, 1 };
+                const glm::vec2 p1 = matrix * glm::vec3 { size.x, 0, 1 };
+                const glm::vec2 p2 = matrix * glm::vec3 { size.x, size.y, 1 };
+                const glm::vec2 p3 = matrix * glm::vec3 { 0, size.y, 1 };
+                return AABB::fromQuad( { p0, 0 }, { p1, 0 }, { p2, 0 }, { p3, 0 } );
+            },
+            []( const SpriteBlitCommand& cmd ) {
+                const glm::ivec2 offset = cmd.sprite.getTrimOffset();
+                return AABB::fromRect( RectI { cmd.x + offset.x, cmd.y + offset.y, cmd.sprite.getTrimRect().width - 1, cmd.sprite.getTrimRect().height - 1 } );
+            },
+            []( const MaskCommand& cmd ) {
+                return AABB::fromRect( RectI { cmd.x, cmd.y, ( cmd.srcRect.width + cmd.step - 1 ) / cmd.step - 1, cmd.srcRect.height - 1 } );
+            },
+            []( const SDFCommand& cmd ) {
+                // The distance field and its shadow.
+                const glm::vec2 shadowOffset = cmd.style.shadowColor.a > 0 ? cmd.style.shadowOffset : glm::vec2 { 0.0f };
+                const glm::vec2 size         = glm::vec2 { cmd.srcRect.width, cmd.srcRect.height } * cmd.scale;
+                const glm::vec2 min          = glm::min( cmd.position, cmd.position + shadowOffset );
+                const glm::vec2 max          = glm::max( cmd.position + size, cmd.position + size + shadowOffset );
+                return AABB::fromMinMax( { glm::floor( min ), 0 }, { glm::ceil( max ) - 1.0f, 0 } );
+            } },
+        command );
+}
+
+void TiledRenderer::execute( Image& image, const Command& command, const AABB& clip ) noexcept
+{
+    std::visit(
+        overloaded {
+            [&]( const ClearCommand& cmd ) {
+                image.rasterClear( cmd.color, clip );
+            },
+            [&]( const CopyCommand& cmd ) {
+                image.rasterCopy( *cmd.image, cmd.x, cmd.y, clip );
+            },
+            [&]( const ScaledCopyCommand& cmd ) {
+                image.rasterCopy( *cmd.image, cmd.srcAABB, cmd.dstAABB, cmd.blendMode, clip );
+            },
+            [&]( const LineCommand& cmd ) {
+                image.rasterLine( cmd.x0, cmd.y0, cmd.x1, cmd.y1, cmd.color, cmd.blendMode, clip );
+            },
+            [&]( const TriangleCommand& cmd ) {
+                image.rasterTriangle( cmd.p0, cmd.p1, cmd.p2, cmd.color, cmd.blendMode, clip );
+            },
+            [&]( const QuadCommand& cmd ) {
+                image.rasterQuad( cmd.p0, cmd.p1, cmd.p2, cmd.p3, cmd.color, cmd.blendMode, clip );
+            },
+            [&]( const TexturedQuadCommand& cmd ) {
+                image.rasterQuad( cmd.v0, cmd.v1, cmd.v2, cmd.v3, *cmd.image, cmd.addressMode, cmd.blendMode, clip );
+            },
+            [&]( const AABBCommand& cmd ) {
+                if ( cmd.fillMode == FillMode::WireFrame )
+                    image.rasterAABBOutline( cmd.aabb, cmd.color, cmd.blendMode, clip );
+                else
+                    image.rasterAABB( cmd.aabb, cmd.color, cmd.blendMode, clip );
+            },
+            [&]( const EllipseCommand& cmd ) {
+                image.rasterEllipse( cmd.center, cmd.radii, cmd.thickness, cmd.color, cmd.blendMode, clip );
+            },
+            [&]( const SpriteCommand& cmd ) {
+                image.rasterSprite( cmd.sprite, cmd.matrix, cmd.color, clip );
+            },
+            [&]( const SpriteBlitCommand& cmd ) {
+                image.rasterSprite( cmd.sprite, cmd.x, cmd.y, clip );
+            },
+            [&]( const MaskCommand& cmd ) {
+                image.rasterMask( *cmd.mask, cmd.srcRect, cmd.x, cmd.y, cmd.color, cmd.step, clip );
+            },
+            [&]( const SDFCommand& cmd ) {
+                image.rasterSDF( *cmd.sdf, cmd.srcRect, cmd.position, cmd.scale, cmd.style, clip );
+            } },
+        command );
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <Graphics/AlphaImage.hpp>
+#include <Graphics/BlendMode.hpp>
+#include <Graphics/Color.hpp>
+#include <Graphics/Enums.hpp>
+#include <Graphics/Image.hpp>
+#include <Graphics/SDFStyle.hpp>
+#include <Graphics/Sprite.hpp>
+#include <Graphics/Vertex.hpp>
+
+#include <Math/AABB.hpp>
+
+#include <glm/mat3x3.hpp>
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <variant>
+#include <vector>
+
+namespace Graphics
+{
+
+/// <summary>
+/// Records draw calls for an image and rasterizes them in screen tiles.
+/// Each draw call is binned into all tiles that its screen bounds overlap.
+/// During a flush, every tile is rasterized start to finish by a single thread
+/// in the order the draw calls were recorded (painter's order).
+/// With dirty tracking enabled, the commands of the previous flush are kept and a tile is only
+/// rasterized if its list of commands differs from the previous flush. The pixels of all other tiles
+/// are retained from the previous frame. Commands that reference an image also store the generation of
+/// the image when the command was recorded, so a tile is redrawn if a referenced image changed in place.
+/// </summary>
+class TiledRenderer final
+{
+public:
+    /// <summary>
+    /// The width and height (in pixels) of a screen tile.
+    /// </summary>
+    static constexpr int TileSize = 32;
+
+    struct ClearCommand
+    {
+        Color color;
+
+        bool operator==( const ClearCommand& ) const = default;
+    };
+
+    struct CopyCommand
+    {
+        const Image* image;
+        uint64_t     generation;
+        int          x, y;
+
+        bool operator==( const CopyCommand& ) const = default;
+    };
+
+    struct ScaledCopyCommand
+    {
+        const Image* image;
+        uint64_t     generation;
+        Math::AABB   srcAABB;
+        Math::AABB   dstAABB;
+        BlendMode    blendMode;
+
+        bool operator==( const ScaledCopyCommand& ) const = default;
+    };
+
+    struct LineCommand
+    {
+        int       x0, y0, x1, y1;
+        Color     color;
+        BlendMode blendMode;
+
+        bool operator==( const LineCommand& ) const = default;
+    };
+
+    struct TriangleCommand
+    {
+        glm::vec2 p0, p1, p2;
+        Color     color;
+        BlendMode blendMode;
+
+        bool operator==( const TriangleCommand& ) const = default;
+    };
+
+    struct QuadCommand
+    {
+        glm::vec2 p0, p1, p2, p3;
+        Color     color;
+        BlendMode blendMode;
+
+        bool operator==( const QuadCommand& ) const = default;
+    };
+
+    struct TexturedQuadCommand
+    {
+        Vertex       v0, v1, v2, v3;
+        const Image* image;
+        uint64_t     generation;
+        AddressMode  addressMode;
+        BlendMode    blendMode;
+
+        bool operator==( const TexturedQuadCommand& ) const = default;
+    };
+
+    struct AABBCommand
+    {
+        Math::AABB aabb;
+        Color      color;
+        BlendMode  blendMode;
+        FillMode   fillMode;
+
+        bool operator==( const AABBCommand& ) const = default;
+    };
+
+    struct EllipseCommand
+    {
+        glm::vec2 center;
+        glm::vec2 radii;
+        float     thickness;
+        Color     color;
+        BlendMode blendMode;
+
+        bool operator==( const EllipseCommand& ) const = default;
+    };
+
+    struct SpriteCommand
+    {
+        Sprite    sprite;
+        uint64_t  generation;
+        glm::mat3 matrix;
+        Color     color;
+
+        bool operator==( const SpriteCommand& ) const = default;
+    };
+
+    struct SpriteBlitCommand
+    {
+        Sprite   sprite;
+        uint64_t generation;
+        int      x, y;
+
+        bool operator==( const SpriteBlitCommand& ) const = default;
+    };
+
+    struct MaskCommand
+    {
+        std::shared_ptr<const AlphaImage> mask;
+        uint64_t                          generation;
+        Math::RectI                       srcRect;
+        int                               x, y;
+        Color                             color;
+        int                               step;
+
+        bool operator==( const MaskCommand& ) const = default;
+    };
+
+    struct SDFCommand
+    {
+        std::shared_ptr<const AlphaImage> sdf;
+        uint64_t                          generation;
+        Math::RectI                       srcRect;
+        glm::vec2                         position;
+        float                             scale;
+        SDFStyle                          style;
+
+        bool operator==( const SDFCommand& ) const = default;
+    };
+
+    using Command = std::variant<ClearCommand, CopyCommand, ScaledCopyCommand, LineCommand, TriangleCommand, QuadCommand, TexturedQuadCommand, AABBCommand, EllipseCommand, SpriteCommand, SpriteBlitCommand, MaskCommand, SDFCommand>;
+
+    /// <summary>
+    /// Record a draw command.
+    /// </summary>
+    /// <param name="command">The command to record.</param>
+    void record( Command command );
+
+    /// <summary>
+    /// Bin the recorded commands into the tiles of the image and rasterize them.
+    /// The command list is empty after the flush.
+    /// </summary>
+    /// <param name="image">The image to rasterize the commands to.</param>
+    void flush( Image& image );
+
+    /// <summary>
+    /// Get the number of commands that are currently recorded.
+    /// </summary>
+    size_t getNumCommands() const noexcept
+    {
+        return m_commands.size();
+    }
+
+    /// <summary>
+    /// Enable or disable dirty tracking. Changing the setting forces all tiles to be redrawn on the next flush.
+    /// </summary>
+    /// <param name="enable">`true` to only redraw the tiles that changed since the previous flush.</param>
+    void setDirtyTracking( bool enable );
+
+    /// <summary>
+    /// Check if dirty tracking is enabled.
+    /// </summary>
+    bool isDirtyTracking() const noexcept
+    {
+        return m_dirtyTracking;
+    }
+
+    /// <summary>
+    /// Forget the commands of the previous flush so that all tiles are redrawn on the next flush.
+    /// </summary>
+    void invalidate() noexcept;
+
+    /// <summary>
+    /// Get the number of tiles that were rasterized during the last flush.
+    /// </summary>
+    size_t getNumDirtyTiles() const noexcept
+    {
+        return m_numDirtyTiles;
+    }
+
+private:
+    // Compute the (unclipped) screen bounds of a command.
+    static Math::AABB bounds( const Command& command, const Image& image ) noexcept;
+    // Rasterize the part of a command that is inside the clip AABB.
+    static void execute( Image& image, const Command& command, const Math::AABB& clip ) noexcept;
+    // Check if a tile overlaps exactly the same commands as in the previous flush.
+    bool isClean( const std::vector<uint32_t>& tile, const std::vector<uint32_t>& prevTile ) const noexcept;
+
+    // The recorded commands (in painter's order).
+    std::vector<Command> m_commands;
+    // Per tile, the indices of the commands that overlap the tile.
+    // The vectors are kept between flushes to avoid reallocating each frame.
+    std::vector<std::vector<uint32_t>> m_tiles;
+
+    // Only rasterize the tiles whose commands changed since the previous flush.
+    bool m_dirtyTracking = false;
+    // The commands and tiles of the previous flush (only used with dirty tracking).
+    std::vector<Command>               m_prevCommands;
+    std::vector<std::vector<uint32_t>> m_prevTiles;
+    // The size of the image during the previous flush (0 if the previous commands are invalid).
+    int m_prevWidth  = 0;
+    int m_prevHeight = 0;
+    // The number of tiles that were rasterized during the last flush.
+    size_t m_numDirtyTiles = 0;
+};
+
+}  // namespace Graphics
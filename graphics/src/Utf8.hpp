@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace Graphics
+{
+
+/// <summary>
+/// Decodes the code points of a UTF-8 string in place (without copying or converting the string).
+/// Invalid or truncated sequences are decoded as U+FFFD (the replacement character) and decoding continues with the next byte.
+/// </summary>
+class Utf8Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = char32_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const char32_t*;
+    using reference         = char32_t;
+
+    /// <summary>
+    /// The code point of invalid sequences.
+    /// </summary>
+    static constexpr char32_t Replacement = 0xFFFDu;
+
+    Utf8Iterator() = default;
+
+    Utf8Iterator( const char* pos, const char* end ) noexcept
+    : m_pos { pos }
+    , m_end { end }
+    {
+        decode();
+    }
+
+    char32_t operator*() const noexcept
+    {
+        return m_codePoint;
+    }
+
+    Utf8Iterator& operator++() noexcept
+    {
+        m_pos += m_length;
+        decode();
+        return *this;
+    }
+
+    Utf8Iterator operator++( int ) noexcept
+    {
+        Utf8Iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==( const Utf8Iterator& other ) const noexcept
+    {
+        return m_pos == other.m_pos;
+    }
+
+    /// <summary>
+    /// Get a pointer to the first byte of the current code point in the string.
+    /// </summary>
+    const char* position() const noexcept
+    {
+        return m_pos;
+    }
+
+private:
+    void decode() noexcept
+    {
+        if ( m_pos == m_end )
+        {
+            m_codePoint = 0;
+            m_length    = 0;
+            return;
+        }
+
+        const auto lead = static_cast<uint8_t>( *m_pos );
+
+        // Single byte (ASCII) characters are by far the most common.
+        if ( lead < 0x80u )
+        {
+            m_codePoint = lead;
+            m_length    = 1;
+            return;
+        }
+
+        int      length;
+        char32_t codePoint;
+        char32_t minCodePoint;
+        if ( ( lead & 0xE0u ) == 0xC0u )
+        {
+            length       = 2;
+            codePoint    = lead & 0x1Fu;
+            minCodePoint = 0x80u;
+        }
+        else if ( ( lead & 0xF0u ) == 0xE0u )
+        {
+            length       = 3;
+            codePoint    = lead & 0x0Fu;
+            minCodePoint = 0x800u;
+        }
+        else if ( ( lead & 0xF8u ) == 0xF0u )
+        {
+            length       = 4;
+            codePoint    = lead & 0x07u;
+            minCodePoint = 0x10000u;
+        }
+        else
+        {
+            // A continuation byte without a lead byte.
+            m_codePoint = Replacement;
+            m_length    = 1;
+            return;
+        }
+
+        for ( int i = 1; i < length; ++i )
+        {
+            if ( m_pos + i == m_end || ( static_cast<uint8_t>( m_pos[i] ) & 0xC0u ) != 0x80u )
+            {
+                // Truncated sequence: skip the lead byte only.
+                m_codePoint = Replacement;
+                m_length    = 1;
+                return;
+            }
+            codePoint = ( codePoint << 6 ) | ( static_cast<uint8_t>( m_pos[i] ) & 0x3Fu );
+        }
+
+        // Reject overlong encodings, surrogates, and code points outside of the Unicode range.
+        if ( codePoint < minCodePoint || codePoint > 0x10FFFFu || ( codePoint >= 0xD800u && codePoint <= 0xDFFFu ) )
+            codePoint = Replacement;
+
+        m_codePoint = codePoint;
+        m_length    = length;
+    }
+
+    const char* m_pos       = nullptr;
+    const char* m_end       = nullptr;
+    char32_t    m_codePoint = 0;
+    int         m_length    = 0;
+};
+
+/// <summary>
+/// A view of the code points of a UTF-8 string.
+/// <code>for ( char32_t c: Utf8View { text } )</code> iterates the code points of the text without allocating any memory.
+/// </summary>
+class Utf8View
+{
+public:
+    explicit Utf8View( std::string_view text ) noexcept
+    : m_text { text }
+    {}
+
+    Utf8Iterator begin() const noexcept
+    {
+        return { m_text.data(), m_text.data() + m_text.size() };
+    }
+
+    Utf8Iterator end() const noexcept
+    {
+        return { m_text.data() + m_text.size(), m_text.data() + m_text.size() };
+    }
+
+private:
+    std::string_view m_text;
+};
+
+/// <summary>
+/// Encode a wide string (UTF-16 or UTF-32, depending on the size of wchar_t) as UTF-8.
+/// The result is written to an existing string, so a string that is reused doesn't allocate once it is large enough.
+/// </summary>
+/// <param name="text">The wide string to encode.</param>
+/// <param name="utf8">The string that receives the UTF-8 encoded text (it is cleared first).</param>
+inline void toUtf8( std::wstring_view text, std::string& utf8 )
+{
+    utf8.clear();
+
+    for ( size_t i = 0; i < text.size(); ++i )
+    {
+        auto c = static_cast<char32_t>( text[i] );
+
+        // Combine UTF-16 surrogate pairs.
+        if constexpr ( sizeof( wchar_t ) == 2 )
+        {
+            if ( c >= 0xD800u && c <= 0xDBFFu && i + 1 < text.size() && static_cast<char32_t>( text[i + 1] ) >= 0xDC00u && static_cast<char32_t>( text[i + 1] ) <= 0xDFFFu )
+            {
+                c = 0x10000u + ( ( c - 0xD800u ) << 10 ) + ( static_cast<char32_t>( text[i + 1] ) - 0xDC00u );
+                ++i;
+            }
+        }
+
+        if ( ( c >= 0xD800u && c <= 0xDFFFu ) || c > 0x10FFFFu )
+            c = Utf8Iterator::Replacement;
+
+        if ( c < 0x80u )
+        {
+            utf8.push_back( static_cast<char>( c ) );
+        }
+        else if ( c < 0x800u )
+        {
+            utf8.push_back( static_cast<char>( 0xC0u | ( c >> 6 ) ) );
+            utf8.push_back( static_cast<char>( 0x80u | ( c & 0x3Fu ) ) );
+        }
+        else if ( c < 0x10000u )
+        {
+            utf8.push_back( static_cast<char>( 0xE0u | ( c >> 12 ) ) );
+            utf8.push_back( static_cast<char>( 0x80u | ( ( c >> 6 ) & 0x3Fu ) ) );
+            utf8.push_back( static_cast<char>( 0x80u | ( c & 0x3Fu ) ) );
+        }
+        else
+        {
+            utf8.push_back( static_cast<char>( 0xF0u | ( c >> 18 ) ) );
+            utf8.push_back( static_cast<char>( 0x80u | ( ( c >> 12 ) & 0x3Fu ) ) );
+            utf8.push_back( static_cast<char>( 0x80u | ( ( c >> 6 ) & 0x3Fu ) ) );
+            utf8.push_back( static_cast<char>( 0x80u | ( c & 0x3Fu ) ) );
+        }
+    }
+}
+
+}  // namespace Graphics
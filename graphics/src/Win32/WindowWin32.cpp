@@ -320,9 +320,10 @@ void WindowWin32::present( const Image& image )
 {
     makeCurrent();
 
-    // Copy the image data to the texture
+    // Copy the image data to the texture.
+    // The pixels are uploaded as BGRA (the memory layout of Color), which the driver copies without converting.
     glBindTexture( GL_TEXTURE_2D, m_Texture );
-    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>( image.getWidth() ), static_cast<GLsizei>( image.getHeight() ), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.data() );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<GLsizei>( image.getWidth() ), static_cast<GLsizei>( image.getHeight() ), 0, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, image.data() );
     glTextureParameteri( m_Texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
     glTextureParameteri( m_Texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
 